@@ -19,6 +19,8 @@
 
 #include <fcntl.h>       // O_WRONLY
 #include <glib/gstdio.h> // g_unlink()
+#include <map>
+#include <set>
 
 #include "pbd/basename.h"
 #include "pbd/convert.h"
@@ -132,96 +134,80 @@ prepare_audio_track (aafiAudioTrack* aafTrack, Session* s)
 	return at.back ();
 }
 
-static bool
-import_sndfile_as_region (Session* s, struct aafiAudioEssencePointer* aafAudioEssencePtrList, SrcQuality quality, timepos_t& pos, SourceList** oneClipSources, ImportStatus& status, vector<std::shared_ptr<Region>>& regions)
-{
-	SourceList* sources = NULL;
-
-	if (aafAudioEssencePtrList->user) {
-		sources = (SourceList*)aafAudioEssencePtrList->user;
-	} else {
-		sources = new SourceList;
-
-		/* Import the source */
-		status.clear ();
-
-		status.current                 = 1;
-		status.total                   = 1;
-		status.freeze                  = false;
-		status.quality                 = quality;
-		status.replace_existing_source = false;
-		status.split_midi_channels     = false;
-		status.import_markers          = false;
-		status.done                    = false;
-		status.cancel                  = false;
-
-		int channelCount = 0;
-
-		aafiAudioEssencePointer* aafAudioEssencePtr = NULL;
-		AAFI_foreachEssencePointer (aafAudioEssencePtrList, aafAudioEssencePtr)
-		{
-			if (aafAudioEssencePtr->essenceFile->usable_file_path)
-				status.paths.push_back (aafAudioEssencePtr->essenceFile->usable_file_path);
-			else
-				status.paths.push_back (aafAudioEssencePtr->essenceFile->original_file_path);
-
-			channelCount++;
-			PBD::info << string_compose ("AAF: Preparing to import clip channel %1: %2\n", channelCount, aafAudioEssencePtr->essenceFile->unique_name);
-		}
-
-		s->import_files (status);
+/* Media of one AAF clip (one file per channel), and its position in
+ * the list of files that are imported in one batch.
+ */
+struct AAFImportJob {
+	AAFImportJob (aafiAudioEssencePointer* l, size_t f)
+		: essencePtrList (l)
+		, first_path (f)
+		, n_paths (0)
+	{}
+
+	aafiAudioEssencePointer* essencePtrList;
+	size_t                   first_path;
+	size_t                   n_paths;
+};
 
-		status.progress = 1.0;
-		sources->clear ();
+static void
+add_clip_import_paths (aafiAudioEssencePointer* aafAudioEssencePtrList, vector<string>& paths, vector<AAFImportJob>& jobs)
+{
+	AAFImportJob job (aafAudioEssencePtrList, paths.size ());
 
-		/* FIXME: There is no way to tell if cancel button was pressed
-		 * or if the file failed to import, just that one of these occurred.
-		 * We want status.cancel to reflect the user's choice only
-		 */
-		if (status.cancel && status.current > 1) {
-			/* Succeeded to import file, assume user hit cancel */
-			return false;
-		} else if (status.cancel && status.current == 1) {
-			/* Failed to import file, assume user did not hit cancel */
-			status.cancel = false;
-			return false;
-		}
+	aafiAudioEssencePointer* aafAudioEssencePtr = NULL;
+	AAFI_foreachEssencePointer (aafAudioEssencePtrList, aafAudioEssencePtr)
+	{
+		if (aafAudioEssencePtr->essenceFile->usable_file_path)
+			paths.push_back (aafAudioEssencePtr->essenceFile->usable_file_path);
+		else
+			paths.push_back (aafAudioEssencePtr->essenceFile->original_file_path);
 
-		for (int i = 0; i < channelCount; i++) {
-			PropertyList proplist;
-			sources->push_back (status.sources.at (i));
+		job.n_paths++;
+		PBD::info << string_compose ("AAF: Preparing to import clip channel %1: %2\n", job.n_paths, aafAudioEssencePtr->essenceFile->unique_name);
+	}
 
-			proplist.add (ARDOUR::Properties::start, 0);
-			proplist.add (ARDOUR::Properties::length, timecnt_t ((*sources)[0]->length (), pos));
-			proplist.add (ARDOUR::Properties::name, aafAudioEssencePtrList->essenceFile->unique_name);
-			proplist.add (ARDOUR::Properties::layer, 0);
-			proplist.add (ARDOUR::Properties::whole_file, true);
-			proplist.add (ARDOUR::Properties::external, true);
+	jobs.push_back (job);
+}
 
-			RegionFactory::create (*sources, proplist);
-		}
+/* Collect the sources of an imported clip, and create a whole-file region
+ * for the source list. On success the sources are stored in the essence
+ * pointer list's user data.
+ */
+static bool
+use_clip_sources (AAFImportJob const& job, ImportStatus const& status)
+{
+	SourceList* sources = new SourceList;
 
-		/* build peakfiles */
-		for (SourceList::iterator x = sources->begin (); x != sources->end (); ++x) {
-			SourceFactory::setup_peakfile (*x, true);
+	for (size_t i = job.first_path; i < job.first_path + job.n_paths; ++i) {
+		if (i >= status.path_sources.size () || status.path_sources[i].empty ()) {
+			delete sources;
+			return false;
 		}
+		sources->push_back (status.path_sources[i].front ());
+	}
 
-		aafAudioEssencePtrList->user = sources;
+	if (sources->empty ()) {
+		delete sources;
+		return false;
 	}
 
-	*oneClipSources = sources;
+	PropertyList proplist;
 
-	/* Put the source on a region */
-	string region_name;
+	proplist.add (ARDOUR::Properties::start, 0);
+	proplist.add (ARDOUR::Properties::length, timecnt_t ((*sources)[0]->length (), timepos_t::max (Temporal::AudioTime)));
+	proplist.add (ARDOUR::Properties::name, job.essencePtrList->essenceFile->unique_name);
+	proplist.add (ARDOUR::Properties::layer, 0);
+	proplist.add (ARDOUR::Properties::whole_file, true);
+	proplist.add (ARDOUR::Properties::external, true);
 
-	/* take all the sources we have and package them up as a region */
-	region_name = region_name_from_path (status.paths.front (), (sources->size () > 1), false);
+	RegionFactory::create (*sources, proplist);
 
-	/* we checked in import_sndfiles() that there were not too many */
-	while (RegionFactory::region_by_name (region_name)) {
-		region_name = bump_name_once (region_name, '.');
+	/* build peakfiles */
+	for (SourceList::iterator x = sources->begin (); x != sources->end (); ++x) {
+		SourceFactory::setup_peakfile (*x, true);
 	}
 
+	job.essencePtrList->user = sources;
 	return true;
 }
 
@@ -558,12 +544,21 @@ ARDOUR_UI::new_session_from_aaf (string const& aaf, string const& target_dir, st
 			break;
 	}
 
-	/* Import Sources */
+	/* Import Sources
+	 *
+	 * First prepare tracks and locate (or extract) the media of all clips,
+	 * then convert all files at once, which import_files() does concurrently,
+	 * and finally create regions and add them to the playlists.
+	 */
 
-	SourceList*                     oneClipSources;
 	ARDOUR::ImportStatus            import_status;
 	vector<std::shared_ptr<Region>> source_regions;
-	timepos_t                       pos = timepos_t::max (Temporal::AudioTime);
+	vector<AAFImportJob>            import_jobs;
+	set<aafiAudioEssencePointer*>   queued_essences;
+	set<aafiAudioClip*>             failed_clips;
+	set<aafiAudioEssenceFile*>      extracted_files;
+
+	map<aafiAudioTrack*, std::shared_ptr<AudioTrack>> tracks;
 
 	aafiAudioTrack*          aafAudioTrack      = NULL;
 	aafiTimelineItem*        aafAudioItem       = NULL;
@@ -574,7 +569,7 @@ ARDOUR_UI::new_session_from_aaf (string const& aaf, string const& target_dir, st
 
 	AAFI_foreachAudioTrack (aafi, aafAudioTrack)
 	{
-		std::shared_ptr<AudioTrack> track = prepare_audio_track (aafAudioTrack, _session);
+		tracks[aafAudioTrack] = prepare_audio_track (aafAudioTrack, _session);
 
 		AAFI_foreachTrackItem (aafAudioTrack, aafAudioItem)
 		{
@@ -589,6 +584,10 @@ ARDOUR_UI::new_session_from_aaf (string const& aaf, string const& target_dir, st
 				continue;
 			}
 
+			if (queued_essences.find (aafAudioClip->essencePointerList) != queued_essences.end ()) {
+				continue;
+			}
+
 			int   essenceError = 0;
 			char* essenceName  = aafAudioClip->essencePointerList->essenceFile->name;
 
@@ -597,17 +596,21 @@ ARDOUR_UI::new_session_from_aaf (string const& aaf, string const& target_dir, st
 				struct aafiAudioEssenceFile* audioEssenceFile = aafAudioEssencePtr->essenceFile;
 
 				if (!audioEssenceFile) {
-					PBD::error << string_compose (_ ("AAF: Could not create new region for clip '%1': Missing audio essence"), audioEssenceFile->unique_name) << endmsg;
+					PBD::error << string_compose (_ ("AAF: Could not create new region for clip '%1': Missing audio essence"), essenceName) << endmsg;
 					essenceError++;
 					continue;
 				}
 
 				if (audioEssenceFile->is_embedded) {
+					if (extracted_files.find (audioEssenceFile) != extracted_files.end ()) {
+						continue;
+					}
 					if (aafi_extractAudioEssenceFile (aafi, audioEssenceFile, AAFI_EXTRACT_DEFAULT, media_cache_path.c_str (), 0, 0, NULL, NULL) < 0) {
 						PBD::error << string_compose ("AAF: Could not extract audio file '%1' from AAF.", audioEssenceFile->unique_name) << endmsg;
 						essenceError++;
 						continue;
 					}
+					extracted_files.insert (audioEssenceFile);
 				} else if (!audioEssenceFile->is_embedded && !audioEssenceFile->usable_file_path) {
 					PBD::error << string_compose ("AAF: Could not locate external audio file: '%1'", audioEssenceFile->original_file_path) << endmsg;
 					essenceError++;
@@ -617,21 +620,81 @@ ARDOUR_UI::new_session_from_aaf (string const& aaf, string const& target_dir, st
 
 			if (essenceError) {
 				PBD::error << string_compose ("AAF: Error parsing audio essence pointerlist : %1\n", essenceName);
+				failed_clips.insert (aafAudioClip);
 				continue;
 			}
 
-			if (!import_sndfile_as_region (_session, aafAudioClip->essencePointerList, SrcBest, pos, &oneClipSources, import_status, source_regions)) {
-				PBD::error << string_compose ("AAF: Could not import '%1' to session.", essenceName) << endmsg;
+			add_clip_import_paths (aafAudioClip->essencePointerList, import_status.paths, import_jobs);
+			queued_essences.insert (aafAudioClip->essencePointerList);
+		}
+	}
+
+	/* Remove extracted media once it has been converted, rather than
+	 * keeping all of it until the whole import is complete.
+	 * The same file may be used by more than one clip.
+	 */
+	map<string, size_t> extracted_refs;
+	for (set<aafiAudioEssenceFile*>::const_iterator f = extracted_files.begin (); f != extracted_files.end (); ++f) {
+		extracted_refs[(*f)->usable_file_path] = 0;
+	}
+	for (vector<string>::const_iterator p = import_status.paths.begin (); p != import_status.paths.end (); ++p) {
+		map<string, size_t>::iterator r = extracted_refs.find (*p);
+		if (r != extracted_refs.end ()) {
+			++r->second;
+		}
+	}
+
+	PBD::ScopedConnection extracted_connection;
+	import_status.InputFileDone.connect_same_thread (extracted_connection, [&extracted_refs] (std::string path) {
+		map<string, size_t>::iterator r = extracted_refs.find (path);
+		if (r != extracted_refs.end () && --r->second == 0) {
+			g_unlink (path.c_str ());
+			extracted_refs.erase (r);
+		}
+	});
+
+	if (!import_status.paths.empty ()) {
+		import_status.current                 = 1;
+		import_status.total                   = import_status.paths.size ();
+		import_status.freeze                  = false;
+		import_status.quality                 = SrcBest;
+		import_status.replace_existing_source = false;
+		import_status.split_midi_channels     = false;
+		import_status.import_markers          = false;
+		import_status.skip_unreadable         = true;
+		import_status.done                    = false;
+		import_status.cancel                  = false;
+
+		_session->import_files (import_status);
+	}
+
+	for (vector<AAFImportJob>::const_iterator j = import_jobs.begin (); j != import_jobs.end (); ++j) {
+		if (!use_clip_sources (*j, import_status)) {
+			PBD::error << string_compose ("AAF: Could not import '%1' to session.", j->essencePtrList->essenceFile->name) << endmsg;
+		}
+	}
+
+	/* extracted files that were not imported */
+	extracted_connection.disconnect ();
+	for (map<string, size_t>::const_iterator r = extracted_refs.begin (); r != extracted_refs.end (); ++r) {
+		g_unlink (r->first.c_str ());
+	}
+
+	AAFI_foreachAudioTrack (aafi, aafAudioTrack)
+	{
+		std::shared_ptr<AudioTrack> track = tracks[aafAudioTrack];
+
+		AAFI_foreachTrackItem (aafAudioTrack, aafAudioItem)
+		{
+			aafAudioClip = aafi_timelineItemToAudioClip (aafAudioItem);
+
+			if (!aafAudioClip || !aafAudioClip->essencePointerList || failed_clips.find (aafAudioClip) != failed_clips.end ()) {
 				continue;
-			} else {
-				AAFI_foreachEssencePointer (aafAudioClip->essencePointerList, aafAudioEssencePtr)
-				{
-					if (aafAudioEssencePtr->essenceFile->is_embedded) {
-						g_unlink (aafAudioEssencePtr->essenceFile->usable_file_path);
-					}
-				}
 			}
 
+			char*       essenceName    = aafAudioClip->essencePointerList->essenceFile->name;
+			SourceList* oneClipSources = (SourceList*)aafAudioClip->essencePointerList->user;
+
 			if (!oneClipSources || oneClipSources->size () == 0) {
 				error << string_compose (_ ("AAF: Could not create new region for clip '%1': Region has no source"), essenceName) << endmsg;
 				continue;
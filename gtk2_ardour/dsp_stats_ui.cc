@@ -18,11 +18,14 @@
 
 #include <gtkmm/frame.h>
 
+#include "pbd/compose.h"
+
 #include "gtkmm2ext/utils.h"
 
 #include "ardour/session.h"
 #include "ardour/audioengine.h"
 #include "ardour/audio_backend.h"
+#include "ardour/worker.h"
 
 #include "widgets/tooltips.h"
 
@@ -39,6 +42,9 @@ using namespace Gtk;
 
 DspStatisticsGUI::DspStatisticsGUI ()
 	: buffer_size_label ("", ALIGN_END, ALIGN_CENTER)
+	, event_stats_label ("", ALIGN_END, ALIGN_CENTER)
+	, worker_stats_label ("", ALIGN_END, ALIGN_CENTER)
+	, capture_load_label ("", ALIGN_END, ALIGN_CENTER)
 	, reset_button (_("Reset"))
 {
 	const size_t nlabels = Session::NTT + AudioEngine::NTT + AudioBackend::NTT;
@@ -80,6 +86,18 @@ DspStatisticsGUI::DspStatisticsGUI ()
 	table.attach (*labels[AudioEngine::NTT + Session::OverallProcess], 2, 3, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
 	row++;
 
+	table.attach (*manage (new Gtk::Label (_("Session events: "), ALIGN_END, ALIGN_CENTER)), 0, 1, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	table.attach (event_stats_label, 2, 3, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	row++;
+
+	table.attach (*manage (new Gtk::Label (_("Capture buffer: "), ALIGN_END, ALIGN_CENTER)), 0, 1, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	table.attach (capture_load_label, 2, 3, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	row++;
+
+	table.attach (*manage (new Gtk::Label (_("Plugin workers: "), ALIGN_END, ALIGN_CENTER)), 0, 1, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	table.attach (worker_stats_label, 2, 3, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	row++;
+
 	HBox* hbox2 = manage (new HBox);
 	hbox2->pack_start (reset_button, true, true);
 
@@ -235,6 +253,14 @@ DspStatisticsGUI::update ()
 
 		ArdourWidgets::set_tooltip (labels[AudioEngine::NTT + Session::OverallProcess], buf);
 
+		snprintf (buf, sizeof (buf), "%u / %u / %u", _session->get_event_pool_high_water (), _session->get_event_pool_stall_count (), _session->get_dropped_event_count ());
+		event_stats_label.set_text (buf);
+		ArdourWidgets::set_tooltip (event_stats_label, _("Peak number of events allocated from a single pool / number of times a thread had to wait for free events / number of events dropped because the queue to the process thread was full"));
+
+		snprintf (buf, sizeof (buf), "%u%% / %u%%", _session->capture_load (), _session->capture_min_load ());
+		capture_load_label.set_text (buf);
+		ArdourWidgets::set_tooltip (capture_load_label, _("Free capture buffer space now / lowest free space during the current or last take, of the track closest to an overrun"));
+
 		/* Subtract session time from engine process time to show
 		 * engine overhead
 		 */
@@ -285,6 +311,25 @@ DspStatisticsGUI::update ()
 
 		labels[AudioEngine::NTT + Session::OverallProcess]->set_text (_("No session loaded"));
 		ArdourWidgets::set_tooltip (labels[AudioEngine::NTT + Session::OverallProcess], "");
+
+		event_stats_label.set_text (not_measured_string);
+		ArdourWidgets::set_tooltip (event_stats_label, "");
+
+		capture_load_label.set_text (not_measured_string);
+		ArdourWidgets::set_tooltip (capture_load_label, "");
+	}
+
+	WorkerPool::Stats ws;
+	if (WorkerPool::get_stats (ws)) {
+		snprintf (buf, sizeof (buf), "%u / %7.2f %s", ws.max_queued, ws.max_latency / 1000.0, str_msec);
+		worker_stats_label.set_text (buf);
+		ArdourWidgets::set_tooltip (worker_stats_label,
+				string_compose (_("Peak number of queued requests / max. time until a request was done\n"
+				                  "%1 threads serving %2 workers, %3 requests processed, %4: %5 %6"),
+				                ws.n_threads, ws.n_workers, ws.processed, str_average, ws.avg_latency / 1000.0, str_msec));
+	} else {
+		worker_stats_label.set_text (not_measured_string);
+		ArdourWidgets::set_tooltip (worker_stats_label, "");
 	}
 }
 
@@ -44,6 +44,9 @@ private:
 
 	Gtk::Table table;
 	Gtk::Label buffer_size_label;
+	Gtk::Label event_stats_label;
+	Gtk::Label worker_stats_label;
+	Gtk::Label capture_load_label;
 	Gtk::Label** labels;
 	Gtk::Button reset_button;
 	Gtk::Label info_text;
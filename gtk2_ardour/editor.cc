@@ -37,6 +37,7 @@
 #include <cmath>
 #include <string>
 #include <algorithm>
+#include <iomanip>
 #include <map>
 
 #include "ardour_ui.h"
@@ -1676,6 +1677,7 @@ Editor::loudness_analyze_region_selection ()
 	ag.Progress.connect_same_thread (c, std::bind (&SimpleProgressDialog::update_progress, &spd, _1, _2));
 	spd.show();
 
+	std::list<std::shared_ptr<AudioRegion> > regions;
 	for (RegionSelection::iterator j = ars.begin (); j != ars.end (); ++j) {
 		AudioRegionView* arv = dynamic_cast<AudioRegionView*> (*j);
 		if (!arv) {
@@ -1685,11 +1687,17 @@ Editor::loudness_analyze_region_selection ()
 		if (!ar) {
 			continue;
 		}
-		ag.analyze_region (ar);
+		regions.push_back (ar);
 	}
+	ag.analyze_regions (regions);
 	spd.hide();
 	if (!ag.canceled ()) {
-		ExportReport er (_("Audio Report/Analysis"), ag.results ());
+		float       integrated, range;
+		std::string summary;
+		if (ag.combined_loudness (&integrated, &range)) {
+			summary = string_compose (_("All regions, played one after another: %1 LUFS integrated, %2 LU loudness range"), std::setprecision (1), std::fixed, integrated, range);
+		}
+		ExportReport er (_("Audio Report/Analysis"), ag.results (), summary);
 		er.run();
 	}
 }
@@ -1738,7 +1746,12 @@ Editor::loudness_analyze_range_selection ()
 	}
 	spd.hide();
 	if (!ag.canceled ()) {
-		ExportReport er (_("Audio Report/Analysis"), ag.results ());
+		float       integrated, range;
+		std::string summary;
+		if (ag.combined_loudness (&integrated, &range)) {
+			summary = string_compose (_("All ranges, played one after another: %1 LUFS integrated, %2 LU loudness range"), std::setprecision (1), std::fixed, integrated, range);
+		}
+		ExportReport er (_("Audio Report/Analysis"), ag.results (), summary);
 		er.run();
 	}
 }
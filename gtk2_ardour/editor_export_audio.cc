@@ -576,6 +576,7 @@ Editor::write_region (string path, std::shared_ptr<AudioRegion> region)
 	now = localtime (&tnow);
 
 	for (vector<std::shared_ptr<AudioFileSource> >::iterator src = sources.begin(); src != sources.end(); ++src) {
+		(*src)->done_with_peakfile_writes ();
 		(*src)->update_header (0, *now, tnow);
 		(*src)->mark_immutable ();
 	}
@@ -738,6 +739,7 @@ Editor::write_audio_range (AudioPlaylist& playlist, const ChanCount& count, list
 	now = localtime (&tnow);
 
 	for (vector<std::shared_ptr<AudioFileSource> >::iterator s = sources.begin(); s != sources.end(); ++s) {
+		(*s)->done_with_peakfile_writes ();
 		(*s)->update_header (0, *now, tnow);
 		(*s)->mark_immutable ();
 		// do we need to ref it again?
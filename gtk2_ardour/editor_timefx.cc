@@ -22,13 +22,17 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <atomic>
 #include <iostream>
 #include <cstdlib>
 #include <cmath>
 #include <ctime>
+#include <memory>
 #include <string>
 #include <set>
+#include <vector>
 
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 #include "pbd/pthread_utils.h"
 #include "pbd/memento_command.h"
@@ -360,13 +364,41 @@ Editor::time_fx (RegionList& regions, Temporal::ratio_t ratio, bool pitching, bo
 	return current_timefx->status;
 }
 
+namespace {
+
+/** Progress of a single region, aggregated by Editor::do_timefx */
+class TimeFXJobProgress : public PBD::Progress
+{
+public:
+	TimeFXJobProgress () : _progress (0) {}
+	float progress () const { return _progress.load (); }
+
+private:
+	void set_overall_progress (float p) { _progress.store (p); }
+	std::atomic<float> _progress;
+};
+
+struct TimeFXJob {
+	TimeFXJob (std::shared_ptr<AudioRegion> r, Filter* f) : region (r), fx (f), done (false) {}
+
+	std::shared_ptr<AudioRegion> region;
+	std::unique_ptr<Filter>      fx;
+	TimeFXJobProgress            progress;
+	std::atomic<bool>            done;
+};
+
+}
+
 void
 Editor::do_timefx (bool fixed_end)
 {
 	typedef std::map<std::shared_ptr<Region>, std::shared_ptr<Region> > ResultMap;
 	ResultMap results;
 
-	uint32_t const N = current_timefx->regions.size ();
+	/* Each region is processed independently, with its own stretcher,
+	 * so distribute them over all cores.
+	 */
+	std::vector<std::unique_ptr<TimeFXJob>> jobs;
 
 	for (RegionList::const_iterator i = current_timefx->regions.begin(); i != current_timefx->regions.end(); ++i) {
 
@@ -377,10 +409,6 @@ Editor::do_timefx (bool fixed_end)
 			continue;
 		}
 
-		if (current_timefx->request.cancel) {
-			break;
-		}
-
 		Filter* fx;
 
 		if (current_timefx->pitching) {
@@ -401,20 +429,76 @@ Editor::do_timefx (bool fixed_end)
 #endif
 		}
 
-		current_timefx->descend (1.0 / N);
+		jobs.push_back (std::unique_ptr<TimeFXJob> (new TimeFXJob (region, fx)));
+	}
 
-		if (fx->run (region, current_timefx)) {
-			current_timefx->request.cancel = true;
-			delete fx;
-			break;
+	std::atomic<size_t> next_job (0);
+
+	auto worker = [&] () {
+		Temporal::TempoMap::fetch ();
+		size_t j;
+		while ((j = next_job.fetch_add (1)) < jobs.size () && !current_timefx->request.cancel) {
+			TimeFXJob& job (*jobs[j]);
+			if (job.fx->run (job.region, &job.progress)) {
+				current_timefx->request.cancel = true;
+				job.fx->results.clear ();
+			}
+			job.done = true;
+		}
+	};
+
+	const size_t n_threads = std::min<size_t> (std::max<uint32_t> (1, hardware_concurrency ()), jobs.size ());
+	std::vector<PBD::Thread*> threads;
+
+	for (size_t i = 0; n_threads > 1 && i < n_threads; ++i) {
+		PBD::Thread* t = PBD::Thread::create (worker, string_compose ("TimeFX-%1", i));
+		if (t) {
+			threads.push_back (t);
+		}
+	}
+
+	if (threads.empty ()) {
+		/* process in this thread, one region after another */
+		for (auto& job : jobs) {
+			if (current_timefx->request.cancel) {
+				break;
+			}
+			current_timefx->descend (1.0 / jobs.size ());
+			if (job->fx->run (job->region, current_timefx)) {
+				current_timefx->request.cancel = true;
+				job->fx->results.clear ();
+			}
+			job->done = true;
+			current_timefx->ascend ();
+		}
+	} else {
+		/* aggregate progress of all jobs */
+		for (bool done = false; !done;) {
+			Glib::usleep (100000);
+			float total = 0;
+			done = true;
+			for (auto const& job : jobs) {
+				if (job->done) {
+					total += 1.f;
+				} else {
+					total += job->progress.progress ();
+					done = false;
+				}
+			}
+			current_timefx->set_progress (total / jobs.size ());
+			done = done || current_timefx->request.cancel;
 		}
 
-		if (!fx->results.empty()) {
-			results[region] = fx->results.front();
+		for (auto& t : threads) {
+			t->join ();
+			delete t;
 		}
+	}
 
-		current_timefx->ascend ();
-		delete fx;
+	for (auto const& job : jobs) {
+		if (job->done && !job->fx->results.empty ()) {
+			results[job->region] = job->fx->results.front ();
+		}
 	}
 
 	pthread_setcancelstate (PTHREAD_CANCEL_DISABLE, NULL);
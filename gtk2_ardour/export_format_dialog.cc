@@ -631,6 +631,21 @@ ExportFormatDialog::init_format_table ()
 	row[src_quality_cols.id]    = ExportFormatBase::SRC_SincFast;
 	row[src_quality_cols.label] = _("Fast (sinc)");
 
+	iter                        = src_quality_list->append ();
+	row                         = *iter;
+	row[src_quality_cols.id]    = ExportFormatBase::SRC_ZitaBest;
+	row[src_quality_cols.label] = _("Best (zita)");
+
+	iter                        = src_quality_list->append ();
+	row                         = *iter;
+	row[src_quality_cols.id]    = ExportFormatBase::SRC_ZitaMedium;
+	row[src_quality_cols.label] = _("Medium (zita)");
+
+	iter                        = src_quality_list->append ();
+	row                         = *iter;
+	row[src_quality_cols.id]    = ExportFormatBase::SRC_ZitaFast;
+	row[src_quality_cols.label] = _("Fast (zita)");
+
 	iter                        = src_quality_list->append ();
 	row                         = *iter;
 	row[src_quality_cols.id]    = ExportFormatBase::SRC_Linear;
@@ -63,7 +63,7 @@ ExportReport::ExportReport (Session* session, StatusPtr s)
 	init (s->result_map, true);
 }
 
-ExportReport::ExportReport (const std::string & title, const AnalysisResults & ar)
+ExportReport::ExportReport (const std::string & title, const AnalysisResults & ar, const std::string & summary)
 	: ArdourDialog (title)
 	, _session (0)
 	, stop_btn (0)
@@ -71,6 +71,11 @@ ExportReport::ExportReport (const std::string & title, const AnalysisResults & a
 	, _audition_num (-1)
 	, _page_num (0)
 {
+	if (!summary.empty ()) {
+		Label* l = manage (new Label (summary, ALIGN_START));
+		get_vbox ()->pack_start (*l, false, false, 4);
+		l->show ();
+	}
 	init (ar, false);
 }
 
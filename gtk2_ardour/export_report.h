@@ -189,7 +189,8 @@ class ExportReport : public ArdourDialog
 public:
 	typedef std::shared_ptr<ARDOUR::ExportStatus> StatusPtr;
 	ExportReport (ARDOUR::Session*, StatusPtr);
-	ExportReport (const std::string & title, const ARDOUR::AnalysisResults & ar);
+	/** @param summary optional text that is displayed above the results */
+	ExportReport (const std::string & title, const ARDOUR::AnalysisResults & ar, const std::string & summary = "");
 	int run ();
 
 	void on_response (int response_id) {
@@ -1753,6 +1753,7 @@ MidiCueEditor::set_region (std::shared_ptr<ARDOUR::MidiRegion> r)
 	}
 
 	view->set_region (r);
+	view->load_model ();
 
 	/* Compute zoom level to show entire source plus some margin if possible */
 
@@ -56,6 +56,7 @@
 #include "evoral/midi_util.h"
 
 #include "canvas/debug.h"
+#include "canvas/rectangle.h"
 
 #include "automation_region_view.h"
 #include "automation_time_axis.h"
@@ -102,6 +103,45 @@ using Gtkmm2ext::Keyboard;
 
 #define MIDI_BP_ZERO ((Config->get_first_midi_bank_is_zero())?0:1)
 
+/* Deferred models are not loaded when zoomed out further than this,
+ * notes are not discernible anyway.
+ */
+static const double max_model_load_seconds_per_pixel = 0.1;
+
+/** An invisible item that spans the region. The canvas prepares it for
+ * rendering when it becomes visible, which loads a deferred model of the
+ * region's source (from an idle callback, not while rendering).
+ */
+class MidiRegionView::ModelLoader : public ArdourCanvas::Rectangle, public sigc::trackable
+{
+public:
+	ModelLoader (ArdourCanvas::Item* parent, MidiRegionView& rv)
+		: ArdourCanvas::Rectangle (parent)
+		, _rv (rv)
+	{
+		set_fill (false);
+		set_outline (false);
+		set_ignore_events (true);
+		CANVAS_DEBUG_NAME (this, "MIDI model loader");
+	}
+
+	~ModelLoader ()
+	{
+		_idle_connection.disconnect ();
+	}
+
+	void prepare_for_render (ArdourCanvas::Rect const&) const
+	{
+		if (!_idle_connection.connected () && visible ()) {
+			_idle_connection = Glib::signal_idle ().connect (sigc::mem_fun (_rv, &MidiRegionView::load_model_if_visible));
+		}
+	}
+
+private:
+	MidiRegionView&          _rv;
+	mutable sigc::connection _idle_connection;
+};
+
 MidiRegionView::MidiRegionView (ArdourCanvas::Container*      parent,
                                 EditingContext&               ec,
                                 RouteTimeAxisView&            tv,
@@ -110,6 +150,7 @@ MidiRegionView::MidiRegionView (ArdourCanvas::Container*      parent,
                                 uint32_t                      basic_color)
 	: RegionView (parent, tv, r, spu, basic_color)
 	, MidiView (std::dynamic_pointer_cast<MidiTrack> (tv.stripable()), *group, ec, *dynamic_cast<MidiStreamView*>(tv.view()), basic_color)
+	, _model_loader (0)
 {
 	connect_to_diskstream ();
 }
@@ -124,6 +165,7 @@ MidiRegionView::MidiRegionView (ArdourCanvas::Container*      parent,
                                 TimeAxisViewItem::Visibility  visibility)
 	: RegionView (parent, tv, r, spu, basic_color, recording, visibility)
 	, MidiView (std::dynamic_pointer_cast<MidiTrack> (tv.stripable()), *group, ec, *dynamic_cast<MidiStreamView*>(tv.view()), basic_color)
+	, _model_loader (0)
 {
 	connect_to_diskstream ();
 }
@@ -132,6 +174,7 @@ MidiRegionView::MidiRegionView (const MidiRegionView& other)
 	: sigc::trackable(other)
 	, RegionView (other)
 	, MidiView (other)
+	, _model_loader (0)
 {
 	init (false);
 }
@@ -139,6 +182,7 @@ MidiRegionView::MidiRegionView (const MidiRegionView& other)
 MidiRegionView::MidiRegionView (const MidiRegionView& other, std::shared_ptr<MidiRegion> region)
 	: RegionView (other, std::shared_ptr<Region> (region))
 	, MidiView (other)
+	, _model_loader (0)
 {
 	init (true);
 }
@@ -154,6 +198,11 @@ MidiRegionView::init (bool /*wfd*/)
 
 	set_region (std::dynamic_pointer_cast<MidiRegion> (_region));
 
+	if (!_model) {
+		_model_loader = new ModelLoader (group, *this);
+		_model_loader->set (ArdourCanvas::Rect (0, 0, std::max (1.0, _pixel_width), _height));
+	}
+
 	//set_height (trackview.current_height());
 
 	region_muted ();
@@ -639,11 +688,36 @@ MidiRegionView::~MidiRegionView ()
 	RegionViewGoingAway (this); /* EMIT_SIGNAL */
 }
 
+/** Called from an idle callback, once the region became visible */
+bool
+MidiRegionView::load_model_if_visible ()
+{
+	if (_model || !_model_loader || !_model_loader->visible ()) {
+		return false;
+	}
+
+	if (_editing_context.get_current_zoom () > _region->session ().sample_rate () * max_model_load_seconds_per_pixel) {
+		/* try again when zooming in, which prepares the loader for rendering */
+		return false;
+	}
+
+	_model_loader->hide ();
+	load_model ();
+
+	/* add the notes to the track's note range */
+	midi_stream_view ()->model_loaded (this);
+	return false;
+}
+
 void
 MidiRegionView::reset_width_dependent_items (double pixel_width)
 {
 	RegionView::reset_width_dependent_items(pixel_width);
 
+	if (_model_loader) {
+		_model_loader->set_x1 (std::max (1.0, pixel_width));
+	}
+
 	view_changed ();
 
 	bool hide_all = false;
@@ -667,6 +741,10 @@ MidiRegionView::set_height (double height)
 {
 	MidiView::set_height (height);
 	RegionView::set_height(height);
+
+	if (_model_loader) {
+		_model_loader->set_y1 (height);
+	}
 }
 void
 MidiRegionView::set_selected (bool selected)
@@ -174,6 +174,11 @@ public:
 	double contents_height() const { return (_height - TimeAxisViewItem::NAME_HIGHLIGHT_SIZE - 2); }
 
 	void connect_to_diskstream ();
+
+	/* load a deferred model once the region is displayed */
+	class ModelLoader;
+	ModelLoader* _model_loader;
+	bool load_model_if_visible ();
 };
 
 
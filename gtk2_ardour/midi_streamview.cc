@@ -191,15 +191,27 @@ MidiStreamView::display_region (MidiRegionView* region_view, bool)
 		return;
 	}
 
-	if (!source->model()) {
-		error << _("attempt to display MIDI region with no model") << endmsg;
+	/* A deferred model is loaded by the region view once it is visible
+	 * at a zoom-level that shows notes, see MidiRegionView::load_model_if_visible
+	 */
+	std::shared_ptr<MidiModel> model = source->loaded_model ();
+	if (!model) {
 		return;
 	}
 
-	_range_dirty = update_data_note_range (source->model()->lowest_note(), source->model()->highest_note());
+	_range_dirty = update_data_note_range (model->lowest_note(), model->highest_note());
 
 	// Display region contents
-	region_view->display_model (source->model());
+	region_view->display_model (model);
+}
+
+void
+MidiStreamView::model_loaded (MidiRegionView* rv)
+{
+	std::shared_ptr<MidiModel> model = rv->model ();
+	if (model) {
+		_range_dirty = update_data_note_range (model->lowest_note(), model->highest_note());
+	}
 }
 
 
@@ -226,8 +238,13 @@ MidiStreamView::update_contents_metrics(std::shared_ptr<Region> r)
 	std::shared_ptr<MidiRegion> mr = std::dynamic_pointer_cast<MidiRegion>(r);
 
 	if (mr) {
+		/* regions are displayed later, that loads deferred models */
+		std::shared_ptr<MidiModel> model = mr->midi_source(0)->loaded_model ();
+		if (!model) {
+			return;
+		}
 		Source::ReaderLock lm (mr->midi_source(0)->mutex());
-		_range_dirty = update_data_note_range (mr->model()->lowest_note(), mr->model()->highest_note());
+		_range_dirty = update_data_note_range (model->lowest_note(), model->highest_note());
 	}
 }
 
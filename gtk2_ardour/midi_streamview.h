@@ -68,6 +68,8 @@ public:
 	void set_layer_display (LayerDisplay);
 	//bool can_change_layer_display() const { return false; } // revert this change for now.  Although stacked view is weirdly implemented wrt the "scroomer", it is still necessary to be able to manage layered regions.
 	void redisplay_track ();
+	/** called by a region view that loaded its deferred model */
+	void model_loaded (MidiRegionView*);
 
 	double contents_height() const {
 		return (child_height() - TimeAxisViewItem::NAME_HIGHLIGHT_SIZE - 2);
@@ -214,6 +214,32 @@ MidiView::region_going_away ()
 	_midi_region.reset ();
 	_model.reset ();
 	connections_requiring_model.drop_connections();
+	source_model_connection.disconnect ();
+}
+
+void
+MidiView::source_model_changed ()
+{
+	if (!_midi_region) {
+		return;
+	}
+
+	std::shared_ptr<MidiModel> m = _midi_region->midi_source (0)->loaded_model ();
+	if (m != _model) {
+		set_model (m);
+	}
+}
+
+void
+MidiView::load_model ()
+{
+	if (!_midi_region || _model) {
+		return;
+	}
+
+	/* this emits ModelChanged, make sure the model is used right away */
+	_midi_region->midi_source (0)->model ();
+	source_model_changed ();
 }
 
 void
@@ -228,7 +254,12 @@ MidiView::set_region (std::shared_ptr<MidiRegion> mr)
 
 	_midi_region->DropReferences.connect (region_going_away_connection, invalidator (*this), std::bind (&MidiView::region_going_away, this), gui_context());
 
-	set_model (_midi_region->midi_source (0)->model());
+	/* Do not load a deferred model here, that is done once the notes are
+	 * displayed or edited (see ::load_model). Pick it up when it is loaded.
+	 */
+	_midi_region->midi_source (0)->ModelChanged.connect (source_model_connection, invalidator (*this), std::bind (&MidiView::source_model_changed, this), gui_context());
+
+	set_model (_midi_region->midi_source (0)->loaded_model());
 }
 
 void
@@ -243,12 +274,9 @@ MidiView::set_model (std::shared_ptr<MidiModel> m)
 	_model = m;
 
 	if (!_model) {
-		std::cerr << "no model!\n";
 		return;
 	}
 
-	std::cerr << "model set to " << _model << std::endl;
-
 	//set_height (trackview.current_height());
 
 #warning paul pianorule needs these fixed
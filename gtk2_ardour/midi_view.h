@@ -121,6 +121,8 @@ class MidiView : public virtual sigc::trackable, public LineMerger
 	void set_region (std::shared_ptr<ARDOUR::MidiRegion>);
 	void set_track (std::shared_ptr<ARDOUR::MidiTrack>);
 	void set_model (std::shared_ptr<ARDOUR::MidiModel>);
+	/** Load the region's model if its source deferred loading it */
+	void load_model ();
 
 	NoteBase* add_note(const std::shared_ptr<NoteType> note, bool visible);
 
@@ -450,8 +452,10 @@ class MidiView : public virtual sigc::trackable, public LineMerger
 	PBD::ScopedConnectionList connections_requiring_model;
 	PBD::ScopedConnection track_going_away_connection;
 	PBD::ScopedConnection region_going_away_connection;
+	PBD::ScopedConnection source_model_connection;
 	void track_going_away ();
 	void region_going_away ();
+	void source_model_changed ();
 
 	void midi_channel_mode_changed ();
 	void instrument_settings_changed ();
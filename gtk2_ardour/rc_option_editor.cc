@@ -3983,6 +3983,16 @@ These settings will only take effect after %1 is restarted.\n\
 	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
 					    _("<b>When enabled</b> plugins will be reset at transport stop. When disabled plugins will be left unchanged at transport stop.\n\nThis mostly affects plugins with a \"tail\" like Reverbs."));
 
+	bo = new BoolOption (
+		"plugins-sleep-on-silence",
+		_("Suspend plugins while their input is silent"),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::get_plugins_sleep_on_silence),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::set_plugins_sleep_on_silence)
+		);
+	add_option (_("Transport"), bo);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+					    _("<b>When enabled</b> effect plugins are not processed once their input has been silent for longer than the plugin's tail-time and latency. Processing resumes as soon as signal is present.\n\nThis reduces DSP load of idle tracks, but plugins that generate sound without input will be muted."));
+
 	/* PLUGINS ******************************************************************/
 
 #if (defined WINDOWS_VST_SUPPORT || defined LXVST_SUPPORT || defined MACVST_SUPPORT || defined AUDIOUNIT_SUPPORT || defined VST3_SUPPORT)
@@ -4826,6 +4836,16 @@ These settings will only take effect after %1 is restarted.\n\
 		procs->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
 
 		add_option (_("Performance"), procs);
+
+		bo = new BoolOption (
+				"parallel-plugin-instances",
+				_("Process replicated plugin instances in parallel"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_parallel_plugin_instances),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_parallel_plugin_instances)
+				);
+		add_option (_("Performance"), bo);
+		Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+				_("<b>When enabled</b> a plugin that is replicated for every channel (e.g. a mono plugin on a multi-channel bus) uses additional DSP threads to process its instances concurrently."));
 	}
 
 #if !(defined PLATFORM_WINDOWS || defined __APPLE__)
@@ -4938,6 +4958,18 @@ These settings will only take effect after %1 is restarted.\n\
 
 	add_option (_("Performance"), new BufferingOptions (_rc_config));
 
+#ifdef __linux__
+	bo = new BoolOption (
+		     "preallocate-capture-files",
+		     _("Preallocate disk space for recordings"),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::get_preallocate_capture_files),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_preallocate_capture_files)
+		     );
+	add_option (_("Performance"), bo);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+			_("When enabled, disk space for audio files being recorded is reserved ahead of time in large contiguous extents. This reduces file-system fragmentation and metadata updates while recording many tracks. Unused space is released when recording stops."));
+#endif
+
 	if (hwcpus > 1) {
 		ComboOption<int32_t>* procs = new ComboOption<int32_t> (
 				"io-thread-count",
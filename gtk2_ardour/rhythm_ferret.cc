@@ -23,9 +23,15 @@
 #include <gtkmm/stock.h>
 #include <gtkmm2ext/utils.h>
 
+#include <atomic>
+#include <memory>
+
+#include "pbd/cpus.h"
 #include "pbd/memento_command.h"
 #include "pbd/convert.h"
+#include "pbd/pthread_utils.h"
 
+#include "ardour/analysis_feature_cache.h"
 #include "ardour/audioregion.h"
 #include "ardour/onset_detector.h"
 #include "ardour/session.h"
@@ -222,6 +228,42 @@ RhythmFerret::get_action () const
 	return SplitRegion;
 }
 
+namespace {
+
+/** Analysis of a single region, prepared in the GUI thread */
+struct OnsetAnalysisJob {
+	OnsetAnalysisJob (std::shared_ptr<AudioRegion> r) : region (r) {}
+
+	std::shared_ptr<AudioRegion>       region;
+	std::unique_ptr<TransientDetector> transient_detector;
+	std::unique_ptr<OnsetDetector>     onset_detector;
+	AnalysisFeatureList                results;
+};
+
+/** Run @p detector on the given channel, unless its result for the same
+ * data and parameters is already known.
+ */
+template <typename Detector> int
+cached_analysis (AnalysisFeatureCache& cache, Detector& detector, std::shared_ptr<AudioRegion> region, uint32_t channel, AnalysisFeatureList& results)
+{
+	std::string const key = AnalysisFeatureCache::key (*region, channel, detector);
+
+	if (cache.lookup (key, results)) {
+		return 0;
+	}
+
+	detector.reset ();
+
+	if (detector.run ("", region.get (), channel, results)) {
+		return -1;
+	}
+
+	cache.insert (key, results);
+	return 0;
+}
+
+}
+
 void
 RhythmFerret::run_analysis ()
 {
@@ -241,57 +283,116 @@ RhythmFerret::run_analysis ()
 		return;
 	}
 
-	for (auto const& r : regions_with_transients) {
+	AnalysisMode const mode        = get_analysis_mode ();
+	float const        trigger_gap = trigger_gap_adjustment.get_value ();
+
+	/* Create and configure detectors here, settings are taken from the
+	 * dialog. Analysis then runs for all regions in parallel.
+	 */
+	std::vector<std::unique_ptr<OnsetAnalysisJob>> jobs;
+
+	try {
+		for (auto const& r : regions_with_transients) {
+
+			std::shared_ptr<AudioRegion> ar = std::dynamic_pointer_cast<AudioRegion> (r);
+			if (!ar) {
+				continue;
+			}
 
-		std::shared_ptr<AudioReadable> rd = std::static_pointer_cast<AudioRegion> (r);
-
-		switch (get_analysis_mode()) {
-		case PercussionOnset:
-			run_percussion_onset_analysis (rd, r->position_sample(), current_results);
-			break;
-		case NoteOnset:
-			run_note_onset_analysis (rd, r->position_sample(), current_results);
-			break;
-		default:
-			break;
+			std::unique_ptr<OnsetAnalysisJob> job (new OnsetAnalysisJob (ar));
+
+			switch (mode) {
+			case PercussionOnset:
+				{
+					float dB = detection_threshold_adjustment.get_value();
+					float coeff = dB > -80.0f ? pow (10.0f, dB * 0.05f) : 0.0f;
+					job->transient_detector.reset (new TransientDetector (_session->sample_rate()));
+					job->transient_detector->set_threshold (coeff);
+					job->transient_detector->set_sensitivity (4, sensitivity_adjustment.get_value());
+				}
+				break;
+			case NoteOnset:
+				job->onset_detector.reset (new OnsetDetector (_session->sample_rate()));
+				job->onset_detector->set_function (get_note_onset_function());
+				job->onset_detector->set_silence_threshold (silence_threshold_adjustment.get_value());
+				job->onset_detector->set_peak_threshold (peak_picker_threshold_adjustment.get_value());
+#ifdef HAVE_AUBIO4
+				job->onset_detector->set_minioi (minioi_adjustment.get_value());
+#endif
+				break;
+			default:
+				break;
+			}
+
+			jobs.push_back (std::move (job));
 		}
+	} catch (failed_constructor& err) {
+		error << (mode == PercussionOnset ? "Could not load percussion onset detection plugin" : "Could not load note onset detection plugin") << endmsg;
+		return;
+	}
 
-		r->set_onsets (current_results);
-		current_results.clear();
+	/* create it now, before it is used by worker threads */
+	(void) _session->analysis_feature_cache ();
+
+	std::atomic<size_t> next_job (0);
+
+	auto worker = [&] () {
+		size_t j;
+		while ((j = next_job.fetch_add (1)) < jobs.size ()) {
+			OnsetAnalysisJob& job (*jobs[j]);
+			if (job.transient_detector) {
+				run_percussion_onset_analysis (job.region, *job.transient_detector, job.results);
+			} else if (job.onset_detector) {
+				run_note_onset_analysis (job.region, *job.onset_detector, trigger_gap, job.results);
+			}
+		}
+	};
+
+	const size_t n_threads = std::min<size_t> (hardware_concurrency (), jobs.size ());
+	std::vector<PBD::Thread*> threads;
+
+	for (size_t i = 0; n_threads > 1 && i < n_threads; ++i) {
+		PBD::Thread* t = PBD::Thread::create (worker, string_compose ("OnsetAnalysis-%1", i));
+		if (t) {
+			threads.push_back (t);
+		}
 	}
-}
 
-int
-RhythmFerret::run_percussion_onset_analysis (std::shared_ptr<AudioReadable> readable, sampleoffset_t /*offset*/, AnalysisFeatureList& results)
-{
-	try {
-		TransientDetector t (_session->sample_rate());
+	if (threads.empty ()) {
+		worker ();
+	}
 
-		for (uint32_t i = 0; i < readable->n_channels(); ++i) {
+	for (auto& t : threads) {
+		t->join ();
+		delete t;
+	}
 
-			AnalysisFeatureList these_results;
+	for (auto const& job : jobs) {
+		job->region->set_onsets (job->results);
+	}
 
-			t.reset ();
-			float dB = detection_threshold_adjustment.get_value();
-			float coeff = dB > -80.0f ? pow (10.0f, dB * 0.05f) : 0.0f;
-			t.set_threshold (coeff);
-			t.set_sensitivity (4, sensitivity_adjustment.get_value());
+	_session->analysis_feature_cache ().save ();
+}
 
-			if (t.run ("", readable.get(), i, these_results)) {
-				continue;
-			}
+int
+RhythmFerret::run_percussion_onset_analysis (std::shared_ptr<AudioRegion> region, TransientDetector& t, AnalysisFeatureList& results)
+{
+	AnalysisFeatureCache& cache (_session->analysis_feature_cache ());
 
-			/* merge */
+	for (uint32_t i = 0; i < region->n_channels(); ++i) {
 
-			results.insert (results.end(), these_results.begin(), these_results.end());
-			these_results.clear ();
+		AnalysisFeatureList these_results;
 
-			t.update_positions (readable.get(), i, results);
+		if (cached_analysis (cache, t, region, i, these_results)) {
+			continue;
 		}
 
-	} catch (failed_constructor& err) {
-		error << "Could not load percussion onset detection plugin" << endmsg;
-		return -1;
+		/* merge */
+
+		results.insert (results.end(), these_results.begin(), these_results.end());
+		these_results.clear ();
+
+		t.update_positions (region.get(), i, results);
 	}
 
 	return 0;
@@ -317,42 +418,27 @@ RhythmFerret::get_note_onset_function ()
 }
 
 int
-RhythmFerret::run_note_onset_analysis (std::shared_ptr<AudioReadable> readable, sampleoffset_t /*offset*/, AnalysisFeatureList& results)
+RhythmFerret::run_note_onset_analysis (std::shared_ptr<AudioRegion> region, OnsetDetector& t, float trigger_gap, AnalysisFeatureList& results)
 {
-	try {
-		OnsetDetector t (_session->sample_rate());
-
-		for (uint32_t i = 0; i < readable->n_channels(); ++i) {
+	AnalysisFeatureCache& cache (_session->analysis_feature_cache ());
 
-			AnalysisFeatureList these_results;
+	for (uint32_t i = 0; i < region->n_channels(); ++i) {
 
-			t.set_function (get_note_onset_function());
-			t.set_silence_threshold (silence_threshold_adjustment.get_value());
-			t.set_peak_threshold (peak_picker_threshold_adjustment.get_value());
-#ifdef HAVE_AUBIO4
-			t.set_minioi (minioi_adjustment.get_value());
-#endif
+		AnalysisFeatureList these_results;
 
-			// aubio-vamp only picks up new settings on reset.
-			t.reset ();
-
-			if (t.run ("", readable.get(), i, these_results)) {
-				continue;
-			}
-
-			/* merge */
-
-			results.insert (results.end(), these_results.begin(), these_results.end());
-			these_results.clear ();
+		// aubio-vamp only picks up new settings on reset, which cached_analysis() does.
+		if (cached_analysis (cache, t, region, i, these_results)) {
+			continue;
 		}
 
-	} catch (failed_constructor& err) {
-		error << "Could not load note onset detection plugin" << endmsg;
-		return -1;
+		/* merge */
+
+		results.insert (results.end(), these_results.begin(), these_results.end());
+		these_results.clear ();
 	}
 
 	if (!results.empty()) {
-		OnsetDetector::cleanup_onsets (results, _session->sample_rate(), trigger_gap_adjustment.get_value());
+		OnsetDetector::cleanup_onsets (results, _session->sample_rate(), trigger_gap);
 	}
 
 	return 0;
@@ -36,7 +36,9 @@
 #include "region_selection.h"
 
 namespace ARDOUR {
-	class AudioReadable;
+	class AudioRegion;
+	class OnsetDetector;
+	class TransientDetector;
 }
 
 class Editor;
@@ -117,8 +119,8 @@ private:
 	int get_note_onset_function ();
 
 	void run_analysis ();
-	int run_percussion_onset_analysis (std::shared_ptr<ARDOUR::AudioReadable> region, ARDOUR::sampleoffset_t offset, ARDOUR::AnalysisFeatureList& results);
-	int run_note_onset_analysis (std::shared_ptr<ARDOUR::AudioReadable> region, ARDOUR::sampleoffset_t offset, ARDOUR::AnalysisFeatureList& results);
+	int run_percussion_onset_analysis (std::shared_ptr<ARDOUR::AudioRegion> region, ARDOUR::TransientDetector&, ARDOUR::AnalysisFeatureList& results);
+	int run_note_onset_analysis (std::shared_ptr<ARDOUR::AudioRegion> region, ARDOUR::OnsetDetector&, float trigger_gap, ARDOUR::AnalysisFeatureList& results);
 
 	void do_action ();
 	void do_split_action ();
@@ -0,0 +1,244 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstring>
+#include <sstream>
+
+#include <glib.h>
+#include <glibmm/fileutils.h>
+
+#include "pbd/error.h"
+
+#include "ardour/analysis_feature_cache.h"
+#include "ardour/audioanalyser.h"
+#include "ardour/audioregion.h"
+#include "ardour/source.h"
+
+#include "pbd/i18n.h"
+
+using namespace std;
+using namespace PBD;
+using namespace ARDOUR;
+
+/* file layout (native byte order):
+ *  magic, uint32 n_entries,
+ *  n_entries * { uint32 key_len, key, uint64 n_features, n_features * int64 }
+ */
+static const char     cache_magic[8] = { 'A', 'R', 'D', 'A', 'F', 'C', '0', '1' };
+static const uint32_t max_key_len    = 65536;
+
+AnalysisFeatureCache::AnalysisFeatureCache (std::string const& path)
+	: _path (path)
+	, _dirty (false)
+{
+	load ();
+}
+
+AnalysisFeatureCache::~AnalysisFeatureCache ()
+{
+	save ();
+}
+
+std::string
+AnalysisFeatureCache::key (AudioRegion const& region, uint32_t channel, AudioAnalyser const& analyser)
+{
+	/* AudioRegion::read() reads directly from its sources, so
+	 * the result only depends on the source, offset and length
+	 */
+	stringstream ss;
+	if (channel < region.sources ().size ()) {
+		ss << region.source (channel)->id ().to_s ();
+	}
+	ss << ':' << channel << ':' << region.start_sample () << ':' << region.length_samples () << ':' << analyser.parameter_key ();
+	return ss.str ();
+}
+
+bool
+AnalysisFeatureCache::lookup (std::string const& key, AnalysisFeatureList& results) const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	FeatureMap::const_iterator i = _features.find (key);
+	if (i == _features.end ()) {
+		return false;
+	}
+	results = i->second;
+	return true;
+}
+
+void
+AnalysisFeatureCache::insert (std::string const& key, AnalysisFeatureList const& results)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	_features[key] = results;
+	_dirty = true;
+}
+
+/* keys start with the ID of the (first) source, see key() */
+static bool
+key_has_source (std::string const& key, std::string const& id)
+{
+	return key.size () > id.size () && key[id.size ()] == ':' && key.compare (0, id.size (), id) == 0;
+}
+
+void
+AnalysisFeatureCache::remove_source (PBD::ID const& id)
+{
+	std::string const sid = id.to_s ();
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+	for (FeatureMap::iterator i = _features.begin (); i != _features.end ();) {
+		if (key_has_source (i->first, sid)) {
+			i = _features.erase (i);
+			_dirty = true;
+		} else {
+			++i;
+		}
+	}
+}
+
+void
+AnalysisFeatureCache::retain_sources (std::set<PBD::ID> const& ids)
+{
+	std::set<std::string> sids;
+	for (auto const& id : ids) {
+		sids.insert (id.to_s ());
+	}
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+	for (FeatureMap::iterator i = _features.begin (); i != _features.end ();) {
+		std::string::size_type colon = i->first.find (':');
+		if (colon != std::string::npos && colon > 0 && sids.find (i->first.substr (0, colon)) == sids.end ()) {
+			i = _features.erase (i);
+			_dirty = true;
+		} else {
+			++i;
+		}
+	}
+}
+
+void
+AnalysisFeatureCache::clear ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	_dirty = !_features.empty ();
+	_features.clear ();
+}
+
+int
+AnalysisFeatureCache::save ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	if (!_dirty) {
+		return 0;
+	}
+
+	string data (cache_magic, sizeof (cache_magic));
+
+	uint32_t n = _features.size ();
+	data.append ((char const*)&n, sizeof (n));
+
+	for (auto const& f : _features) {
+		uint32_t key_len = f.first.size ();
+		uint64_t n_features = f.second.size ();
+		data.append ((char const*)&key_len, sizeof (key_len));
+		data.append (f.first);
+		data.append ((char const*)&n_features, sizeof (n_features));
+		for (auto const& pos : f.second) {
+			int64_t p = pos;
+			data.append ((char const*)&p, sizeof (p));
+		}
+	}
+
+	GError* err = NULL;
+	if (!g_file_set_contents (_path.c_str (), data.data (), data.size (), &err)) {
+		error << string_compose (_("Could not write analysis cache to \"%1\": %2"), _path, err ? err->message : "") << endmsg;
+		if (err) {
+			g_error_free (err);
+		}
+		return -1;
+	}
+
+	_dirty = false;
+	return 0;
+}
+
+int
+AnalysisFeatureCache::load ()
+{
+	if (!Glib::file_test (_path, Glib::FILE_TEST_EXISTS)) {
+		return 0;
+	}
+
+	gchar* contents = NULL;
+	gsize  length   = 0;
+
+	if (!g_file_get_contents (_path.c_str (), &contents, &length, NULL)) {
+		return -1;
+	}
+
+	char const* p   = contents;
+	char const* end = contents + length;
+
+	auto get = [&] (void* dst, size_t len) {
+		if ((size_t)(end - p) < len) {
+			return false;
+		}
+		memcpy (dst, p, len);
+		p += len;
+		return true;
+	};
+
+	FeatureMap features;
+	char       magic[sizeof (cache_magic)];
+	uint32_t   n;
+	bool       ok = get (magic, sizeof (magic)) && !memcmp (magic, cache_magic, sizeof (magic)) && get (&n, sizeof (n));
+
+	for (uint32_t i = 0; ok && i < n; ++i) {
+		uint32_t key_len;
+		uint64_t n_features;
+		if (!get (&key_len, sizeof (key_len)) || key_len > max_key_len || (size_t)(end - p) < key_len) {
+			ok = false;
+			break;
+		}
+		string key (p, key_len);
+		p += key_len;
+
+		if (!get (&n_features, sizeof (n_features)) || (end - p) / sizeof (int64_t) < n_features) {
+			ok = false;
+			break;
+		}
+
+		AnalysisFeatureList& fl (features[key]);
+		for (uint64_t f = 0; f < n_features; ++f) {
+			int64_t pos;
+			get (&pos, sizeof (pos));
+			fl.push_back (pos);
+		}
+	}
+
+	g_free (contents);
+
+	if (!ok) {
+		/* start over, the file will be replaced on next save */
+		warning << string_compose (_("Ignoring invalid analysis cache \"%1\""), _path) << endmsg;
+		return -1;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+	_features.swap (features);
+	return 0;
+}
@@ -17,18 +17,24 @@
  */
 
 
+#include <glibmm/threads.h>
+
+#include "pbd/cpus.h"
 #include "pbd/progress.h"
+#include "pbd/pthread_utils.h"
 
 #include "ardour/analysis_graph.h"
 #include "ardour/route.h"
 #include "ardour/session.h"
 
+#include "temporal/tempo.h"
 #include "temporal/time.h"
 
 #include "audiographer/process_context.h"
 #include "audiographer/general/chunker.h"
 #include "audiographer/general/interleaver.h"
 #include "audiographer/general/analyser.h"
+#include "audiographer/general/loudness_meter.h"
 #include "audiographer/general/peak_reader.h"
 
 #include "pbd/i18n.h"
@@ -42,6 +48,7 @@ AnalysisGraph::AnalysisGraph (Session *s)
 	, _samples_read (0)
 	, _samples_end (0)
 	, _canceled (false)
+	, _n_combined (0)
 {
 	_buf     = (Sample *) malloc(sizeof(Sample) * _max_chunksize);
 	_mixbuf  = (Sample *) malloc(sizeof(Sample) * _max_chunksize);
@@ -63,17 +70,135 @@ AnalysisGraph::analyze_region (std::shared_ptr<AudioRegion> region, bool raw)
 
 void
 AnalysisGraph::analyze_region (AudioRegion const* region, bool raw, PBD::Progress* p)
+{
+	ExportAnalysisPtr rv = run_region (region, raw, _buf, _mixbuf, _gainbuf, [&] (samplecnt_t n) {
+			_samples_read += n;
+			Progress (_samples_read, _samples_end);
+			if (_canceled) {
+				return false;
+			}
+			if (p) {
+				p->set_progress (_samples_read / (float) _samples_end);
+				if (p->cancelled ()) {
+					return false;
+				}
+			}
+			return true;
+		});
+
+	if (rv) {
+		_results.insert (std::make_pair (region->name(), rv));
+	}
+}
+
+void
+AnalysisGraph::analyze_regions (std::list<std::shared_ptr<AudioRegion> > const& regions, bool raw, PBD::Progress* p)
+{
+	std::vector<std::shared_ptr<AudioRegion> > jobs (regions.begin (), regions.end ());
+	std::vector<ExportAnalysisPtr>             results (jobs.size ());
+
+	std::atomic<size_t>      next_job (0);
+	std::atomic<samplecnt_t> samples_read (0);
+
+	uint32_t             n_running = 0;
+	Glib::Threads::Mutex mutex;
+	Glib::Threads::Cond  cond;
+
+	/* each worker has its own read-buffers and analysis chain,
+	 * and keeps pulling regions until all jobs are taken.
+	 */
+	auto worker = [&] () {
+		Temporal::TempoMap::fetch ();
+
+		Sample* buf     = (Sample *) malloc(sizeof(Sample) * _max_chunksize);
+		Sample* mixbuf  = (Sample *) malloc(sizeof(Sample) * _max_chunksize);
+		float*  gainbuf = (float *)  malloc(sizeof(float)  * _max_chunksize);
+
+		size_t j;
+		while ((j = next_job.fetch_add (1)) < jobs.size ()) {
+			results[j] = run_region (jobs[j].get (), raw, buf, mixbuf, gainbuf, [&] (samplecnt_t n) {
+					samples_read.fetch_add (n);
+					return !_canceled && !(p && p->cancelled ());
+				});
+		}
+
+		free (buf);
+		free (mixbuf);
+		free (gainbuf);
+
+		Glib::Threads::Mutex::Lock lm (mutex);
+		--n_running;
+		cond.signal ();
+	};
+
+	const uint32_t n_threads = std::min<size_t> (std::max<uint32_t> (1, hardware_concurrency ()), jobs.size ());
+
+	std::vector<PBD::Thread*> threads;
+	{
+		Glib::Threads::Mutex::Lock lm (mutex);
+		for (uint32_t i = 0; i < n_threads; ++i) {
+			PBD::Thread* t = PBD::Thread::create (worker, string_compose ("Analysis-%1", i));
+			if (t) {
+				threads.push_back (t);
+				++n_running;
+			}
+		}
+	}
+
+	if (threads.empty ()) {
+		/* fall back to analyzing in the calling thread */
+		for (auto const& r : jobs) {
+			analyze_region (r.get (), raw, p);
+		}
+		return;
+	}
+
+	/* aggregate progress of all jobs, and report it from this thread */
+	const samplecnt_t samples_start = _samples_read;
+
+	Glib::Threads::Mutex::Lock lm (mutex);
+	while (n_running > 0) {
+		cond.wait_until (mutex, g_get_monotonic_time () + 100 * G_TIME_SPAN_MILLISECOND);
+		if (n_running == 0) {
+			break;
+		}
+		lm.release ();
+		_samples_read = samples_start + samples_read.load ();
+		Progress (_samples_read, _samples_end);
+		if (p) {
+			p->set_progress (_samples_read / (float) _samples_end);
+		}
+		lm.acquire ();
+	}
+	lm.release ();
+
+	for (auto& t : threads) {
+		t->join ();
+		delete t;
+	}
+
+	_samples_read = samples_start + samples_read.load ();
+
+	for (size_t j = 0; j < jobs.size (); ++j) {
+		if (results[j]) {
+			_results.insert (std::make_pair (jobs[j]->name(), results[j]));
+		}
+	}
+}
+
+ExportAnalysisPtr
+AnalysisGraph::run_region (AudioRegion const* region, bool raw, Sample* buf, Sample* mixbuf, float* gainbuf, std::function<bool (samplecnt_t)> const& progress)
 {
 	int n_channels = region->n_channels();
 	if (n_channels == 0 || n_channels > _max_chunksize) {
-		return;
+		return ExportAnalysisPtr ();
 	}
 	samplecnt_t n_samples = _max_chunksize - (_max_chunksize % n_channels);
 
-	interleaver.reset (new Interleaver<Sample> ());
+	InterleaverPtr interleaver (new Interleaver<Sample> ());
 	interleaver->init (n_channels, _max_chunksize);
-	chunker.reset (new Chunker<Sample> (n_samples));
-	analyser.reset (new Analyser (
+	ChunkerPtr chunker (new Chunker<Sample> (n_samples));
+	AnalysisPtr analyser (new Analyser (
 				_session->nominal_sample_rate(),
 				n_channels,
 				n_samples,
@@ -87,15 +212,15 @@ AnalysisGraph::analyze_region (AudioRegion const* region, bool raw, PBD::Progres
 		samplecnt_t chunk = std::min (_max_chunksize, length - x);
 		samplecnt_t n = 0;
 		for (unsigned int channel = 0; channel < region->n_channels(); ++channel) {
-			memset (_buf, 0, chunk * sizeof (Sample));
+			memset (buf, 0, chunk * sizeof (Sample));
 
 			if (raw) {
-				n = region->read_raw_internal (_buf, region->start_sample() + x, chunk, channel);
+				n = region->read_raw_internal (buf, region->start_sample() + x, chunk, channel);
 			} else {
-				n = region->read_at (_buf, _mixbuf, _gainbuf, region->position_sample() + x, chunk, channel);
+				n = region->read_at (buf, mixbuf, gainbuf, region->position_sample() + x, chunk, channel);
 			}
 
-			ConstProcessContext<Sample> context (_buf, n, 1);
+			ConstProcessContext<Sample> context (buf, n, 1);
 			if (n < _max_chunksize) {
 				context().set_flag (ProcessContext<Sample>::EndOfInput);
 			}
@@ -107,19 +232,44 @@ AnalysisGraph::analyze_region (AudioRegion const* region, bool raw, PBD::Progres
 			}
 		}
 		x += n;
-		_samples_read += n;
-		Progress (_samples_read, _samples_end);
-		if (_canceled) {
-			return;
+		if (!progress (n)) {
+			return ExportAnalysisPtr ();
 		}
-		if (p) {
-			p->set_progress (_samples_read / (float) _samples_end);
-			if (p->cancelled ()) {
-				return;
-			}
+	}
+	return analysis_result (*analyser);
+}
+
+/** Return the result of a completed analysis, and add its loudness
+ * to the combined loudness of all regions or ranges.
+ * This may be called concurrently by analysis threads.
+ */
+ExportAnalysisPtr
+AnalysisGraph::analysis_result (Analyser& a)
+{
+	ExportAnalysisPtr rv = a.result ();
+
+	if (rv && rv->have_loudness) {
+		Glib::Threads::Mutex::Lock lm (_combined_lock);
+		if (!_combined) {
+			/* only the loudness is combined, true-peak is reported separately */
+			_combined.reset (new LoudnessMeter (_session->nominal_sample_rate (), 1, false));
 		}
+		_combined->merge (a.meter ());
+		++_n_combined;
+	}
+
+	return rv;
+}
+
+bool
+AnalysisGraph::combined_loudness (float* integrated, float* range) const
+{
+	if (_n_combined < 2) {
+		return false;
 	}
-	_results.insert (std::make_pair (region->name(), analyser->result ()));
+	*integrated = _combined->integrated ();
+	*range      = _combined->loudness_range ();
+	return *integrated > -200;
 }
 
 void
@@ -179,6 +329,6 @@ AnalysisGraph::analyze_range (std::shared_ptr<Route> route, std::shared_ptr<Audi
 					_session->nominal_sample_rate(),
 					100, false)
 				);
-		_results.insert (std::make_pair (name, analyser->result ()));
+		_results.insert (std::make_pair (name, analysis_result (*analyser)));
 	}
 }
@@ -0,0 +1,72 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+
+#include <glibmm/threads.h>
+
+#include "pbd/id.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class AudioAnalyser;
+class AudioRegion;
+
+/** Session-level cache of analysis results (e.g. onset positions).
+ *
+ * Results are keyed by the data that was analysed (source IDs, channel and
+ * range) and by the analysis plugin and all its parameters, so they remain
+ * valid for as long as the session's (immutable) sources exist. The cache is
+ * kept in a binary file in the session's analysis folder.
+ */
+class LIBARDOUR_API AnalysisFeatureCache
+{
+public:
+	AnalysisFeatureCache (std::string const& path);
+	~AnalysisFeatureCache ();
+
+	static std::string key (AudioRegion const&, uint32_t channel, AudioAnalyser const&);
+
+	bool lookup (std::string const& key, AnalysisFeatureList&) const;
+	void insert (std::string const& key, AnalysisFeatureList const&);
+
+	/** drop all results of the given source */
+	void remove_source (PBD::ID const&);
+	/** drop results of all sources that are not in the given set */
+	void retain_sources (std::set<PBD::ID> const&);
+
+	int  save ();
+	void clear ();
+
+private:
+	int load ();
+
+	typedef std::map<std::string, AnalysisFeatureList> FeatureMap;
+
+	mutable Glib::Threads::Mutex _lock;
+	FeatureMap                   _features;
+	std::string                  _path;
+	bool                         _dirty;
+};
+
+} /* namespace */
@@ -20,11 +20,16 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <list>
 #include <map>
 #include <memory>
 #include <set>
 #include <cstring>
 
+#include <glibmm/threads.h>
+
 #include "ardour/audioregion.h"
 #include "ardour/audioplaylist.h"
 #include "ardour/export_analysis.h"
@@ -32,6 +37,7 @@
 
 namespace AudioGrapher {
 	class Analyser;
+	class LoudnessMeter;
 	template <typename T> class Chunker;
 	template <typename T> class Interleaver;
 }
@@ -50,10 +56,21 @@ class LIBARDOUR_API AnalysisGraph {
 		void analyze_region (ARDOUR::AudioRegion const*, bool raw = false, PBD::Progress* = 0);
 		void analyze_region (std::shared_ptr<ARDOUR::AudioRegion>, bool raw = false);
 
+		/** Analyze several regions concurrently, one region per job.
+		 * Progress is aggregated and emitted from the calling thread.
+		 */
+		void analyze_regions (std::list<std::shared_ptr<ARDOUR::AudioRegion> > const&, bool raw = false, PBD::Progress* = 0);
+
 		void analyze_range (std::shared_ptr<ARDOUR::Route>, std::shared_ptr<ARDOUR::AudioPlaylist>, const std::list<TimelineRange>&);
 
 		const AnalysisResults& results () const { return _results; }
 
+		/** Loudness of all analyzed regions or ranges, as if they were
+		 * played one after another (e.g. the tracks of an album).
+		 * @return false unless the loudness of at least two was measured
+		 */
+		bool combined_loudness (float* integrated, float* range) const;
+
 		void cancel () { _canceled = true; }
 		bool canceled () const { return _canceled; }
 
@@ -61,6 +78,9 @@ class LIBARDOUR_API AnalysisGraph {
 		PBD::Signal<void(samplecnt_t, samplecnt_t)> Progress;
 
 	private:
+		ExportAnalysisPtr run_region (ARDOUR::AudioRegion const*, bool raw, ARDOUR::Sample*, ARDOUR::Sample*, float*, std::function<bool (samplecnt_t)> const&);
+		ExportAnalysisPtr analysis_result (AudioGrapher::Analyser&);
+
 		ARDOUR::Session* _session;
 		AnalysisResults  _results;
 		samplecnt_t       _max_chunksize;
@@ -70,7 +90,7 @@ class LIBARDOUR_API AnalysisGraph {
 		float*           _gainbuf;
 		samplecnt_t       _samples_read;
 		samplecnt_t       _samples_end;
-		bool             _canceled;
+		std::atomic<bool> _canceled;
 
 		typedef std::shared_ptr<AudioGrapher::Analyser> AnalysisPtr;
 		typedef std::shared_ptr<AudioGrapher::Chunker<float> > ChunkerPtr;
@@ -79,5 +99,10 @@ class LIBARDOUR_API AnalysisGraph {
 		InterleaverPtr  interleaver;
 		ChunkerPtr      chunker;
 		AnalysisPtr     analyser;
+
+		/* regions are analyzed concurrently, see analyze_regions () */
+		Glib::Threads::Mutex                          _combined_lock;
+		std::shared_ptr<AudioGrapher::LoudnessMeter> _combined;
+		uint32_t                                      _n_combined;
 };
 } // namespace ARDOUR
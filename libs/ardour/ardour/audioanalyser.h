@@ -51,6 +51,11 @@ class LIBARDOUR_API AudioAnalyser {
 
 	void reset ();
 
+	/** @return a string identifying the plugin and the current value
+	 * of all its parameters, which determine the analysis result.
+	 */
+	std::string parameter_key () const;
+
   protected:
 	float sample_rate;
 	AnalysisPlugin* plugin;
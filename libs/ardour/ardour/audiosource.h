@@ -64,6 +64,19 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 	int read_peaks (PeakData *peaks, samplecnt_t npeaks,
 			samplepos_t start, samplecnt_t cnt, double samples_per_visual_peak) const;
 
+	/** Read peak-file entries as they are stored on disk, without any
+	 * rescaling. This is much cheaper than reading audio data, and allows
+	 * to quickly rule out spans of a source when scanning its data.
+	 *
+	 * @param start first sample, must be a multiple of samples_per_file_peak()
+	 * @param npeaks number of entries to read
+	 * @return true on success, false if peak data is not (yet) available for the given range
+	 */
+	bool read_file_peaks (PeakData* peaks, samplecnt_t npeaks, samplepos_t start) const;
+
+	/** @return number of samples summarized by each entry in the peak-file */
+	static samplecnt_t samples_per_file_peak ();
+
 	int  build_peaks ();
 	bool peaks_ready (std::function<void()> callWhenReady, PBD::ScopedConnection** connection_created_if_not_ready, PBD::EventLoop* event_loop) const;
 
@@ -101,6 +101,12 @@ public:
 
 	float buffer_load () const;
 
+	/** @return lowest buffer_load() seen by the butler since the last
+	 * call to reset_min_buffer_load() or the start of a new take.
+	 */
+	float min_buffer_load () const { return _min_buffer_load.load (); }
+	void  reset_min_buffer_load () { _min_buffer_load = 1.f; }
+
 	int seek (samplepos_t sample, bool complete_refill);
 
 	static PBD::Signal<void()> Overrun;
@@ -192,6 +198,7 @@ private:
 	std::atomic<int> _record_safe;
 	std::atomic<int> _samples_pending_write;
 	std::atomic<int> _num_captured_loops;
+	std::atomic<float> _min_buffer_load;
 
 	std::shared_ptr<SMFSource> _midi_write_source;
 
@@ -18,7 +18,7 @@
 
 #pragma once
 
-#include "ardour/audioanalyser.h"
+#include "ardour/libardour_visibility.h"
 #include "ardour/readable.h"
 
 namespace ARDOUR {
@@ -26,7 +26,7 @@ namespace ARDOUR {
 class AudioSource;
 class Session;
 
-class LIBARDOUR_API EBUr128Analysis : public AudioAnalyser
+class LIBARDOUR_API EBUr128Analysis
 {
 public:
 	EBUr128Analysis (float sample_rate);
@@ -37,10 +37,8 @@ public:
 	float loudness () const { return _loudness; }
 	float loudness_range () const { return _loudness_range; }
 
-protected:
-	int use_features (Vamp::Plugin::FeatureSet&, std::ostream*);
-
 private:
+	float _sample_rate;
 	float _loudness;
 	float _loudness_range;
 
@@ -116,7 +116,13 @@ class LIBARDOUR_API ExportFormatBase {
 		SRC_SincMedium = SRC_SINC_MEDIUM_QUALITY,
 		SRC_SincFast = SRC_SINC_FASTEST,
 		SRC_ZeroOrderHold = SRC_ZERO_ORDER_HOLD,
-		SRC_Linear = SRC_LINEAR
+		SRC_Linear = SRC_LINEAR,
+		/* zita-resampler, 0x100 + filter half-length,
+		 * see AudioGrapher::SampleRateConverter::ZitaQuality
+		 */
+		SRC_ZitaBest = 0x100 + 96,
+		SRC_ZitaMedium = 0x100 + 48,
+		SRC_ZitaFast = 0x100 + 24
 	};
 
 	/// Class for managing selection and compatibility states
@@ -52,6 +52,7 @@ namespace AudioGrapher {
 namespace ARDOUR
 {
 
+class Buffer;
 class ExportTimespan;
 class MidiBuffer;
 class Session;
@@ -89,7 +90,7 @@ class LIBARDOUR_API ExportGraphBuilder
 	ExportGraphBuilder (Session const & session);
 	~ExportGraphBuilder ();
 
-	samplecnt_t process (samplecnt_t samples, bool last_cycle);
+	samplecnt_t process (samplepos_t position, samplecnt_t samples);
 	bool post_process (); // returns true when finished
 	bool need_postprocessing () const { return !intermediates.empty(); }
 	bool realtime() const { return _realtime; }
@@ -101,9 +102,7 @@ class LIBARDOUR_API ExportGraphBuilder
 	void add_config (FileSpec const & config, bool rt);
 	void get_analysis_results (AnalysisResults& results);
 
-	std::vector<std::string> exported_files () const {
-		return _exported_files;
-	}
+	std::vector<std::string> exported_files (std::shared_ptr<ExportTimespan> span) const;
 
   private:
 
@@ -112,10 +111,10 @@ class LIBARDOUR_API ExportGraphBuilder
 	}
 
 	void add_export_fn (std::string const& fn) {
-		_exported_files.push_back (fn);
+		_exported_files.push_back (std::make_pair (timespan, fn));
 	}
 
-	std::vector<std::string> _exported_files;
+	std::vector<std::pair<std::shared_ptr<ExportTimespan>, std::string> > _exported_files;
 
 	void add_split_config (FileSpec const & config);
 
@@ -290,6 +289,7 @@ class LIBARDOUR_API ExportGraphBuilder
 
 		ExportGraphBuilder &      parent;
 		FileSpec                  config;
+		std::shared_ptr<ExportTimespan> timespan;
 		boost::ptr_list<SilenceHandler> children;
 		InterleaverPtr            interleaver;
 		ChunkerPtr                chunker;
@@ -303,8 +303,20 @@ class LIBARDOUR_API ExportGraphBuilder
 	typedef boost::ptr_list<ChannelConfig> ChannelConfigList;
 	ChannelConfigList channel_configs;
 
-	// The sources of all data, each channel is read only once
-	ChannelMap channels;
+	/* Several timespans can be exported in the same pass,
+	 * each one has its own graph fed from the channels.
+	 */
+	struct TimespanChannels {
+		TimespanChannels () : finished (false) {}
+		ChannelMap channels;
+		bool       finished;
+	};
+
+	typedef std::map<std::shared_ptr<ExportTimespan>, TimespanChannels> TimespanMap;
+	TimespanMap timespans;
+
+	// The sources of all data, each channel is read only once per cycle
+	std::map<ExportChannelPtr, Buffer const*> channel_buffers;
 
 	samplecnt_t process_buffer_samples;
 
@@ -315,6 +327,12 @@ class LIBARDOUR_API ExportGraphBuilder
 	bool        _realtime;
 	samplecnt_t _master_align;
 
+	/* Intermediate data (for normalization) of all files being exported
+	 * at the same time is kept in memory up to this size.
+	 */
+	static const size_t max_tmp_memory = 1024 * 1048576;
+	size_t              _tmp_memory_used;
+
 	Glib::ThreadPool     thread_pool;
 	Glib::Threads::Mutex engine_request_lock;
 };
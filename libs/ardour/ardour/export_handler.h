@@ -24,7 +24,9 @@
 #pragma once
 
 #include <map>
+#include <set>
 #include <memory>
+#include <vector>
 
 #include <boost/operators.hpp>
 
@@ -159,10 +161,19 @@ class LIBARDOUR_API ExportHandler : public ExportElementFactory, public sigc::tr
 	int  post_process ();
 	void finish_timespan ();
 
+	bool can_share_pass (ExportTimespanPtr) const;
+	void plan_pass (std::set<ExportTimespanPtr> const& pending, std::vector<ExportTimespanPtr>& pass, samplepos_t& start, samplepos_t& end) const;
+
 	typedef std::pair<ConfigMap::iterator, ConfigMap::iterator> TimespanBounds;
 	ExportTimespanPtr     current_timespan;
 	TimespanBounds        timespan_bounds;
 
+	/* All timespans rendered in the current freewheel pass,
+	 * current_timespan is the first one.
+	 */
+	std::vector<ExportTimespanPtr> current_timespans;
+	samplepos_t           current_end;
+
 	PBD::ScopedConnection process_connection;
 	samplepos_t           process_position;
 
@@ -30,6 +30,7 @@
 #include <vector>
 
 
+#include "pbd/microseconds.h"
 #include "pbd/mpmc_queue.h"
 #include "pbd/semutils.h"
 
@@ -92,6 +93,15 @@ public:
 
 	/* RTTasks */
 	void process_tasklist (RTTaskList const&);
+	void process_nested_tasklist (RTTaskList const&);
+
+	/** @return true if called from a graph-thread while processing a node */
+	static bool in_graph_node ();
+
+	/* optional thread-utilization statistics (off by default) */
+	void set_collect_stats (bool);
+	void reset_stats ();
+	void get_stats (uint64_t& nodes_run, PBD::microseconds_t& busy_time) const;
 
 protected:
 	virtual void session_going_away ();
@@ -99,13 +109,16 @@ protected:
 private:
 	void reset_thread_list ();
 	void drop_threads ();
-	void run_one ();
+	void     run_one ();
+	void     run_nested ();
+	uint32_t wake_idle_threads (uint32_t n);
 	void main_thread ();
 	void prep ();
 
 	void helper_thread ();
 
 	PBD::MPMCQueue<ProcessNode*> _trigger_queue;      ///< nodes that can be processed
+	PBD::MPMCQueue<ProcessNode*> _nested_queue;       ///< tasks dispatched by a node that is being processed
 	std::atomic<uint32_t>        _trigger_queue_size; ///< number of entries in trigger-queue
 
 	/** Start worker threads */
@@ -129,6 +142,11 @@ private:
 	/* flag to terminate background threads */
 	std::atomic<int> _terminate;
 
+	/* statistics: total number of processed nodes and time spent processing them */
+	std::atomic<bool>     _collect_stats;
+	std::atomic<uint64_t> _stats_nodes_run;
+	std::atomic<uint64_t> _stats_busy_time;
+
 	/* graph chain */
 	GraphChain const* _graph_chain;
 
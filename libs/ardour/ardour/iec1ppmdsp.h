@@ -31,6 +31,7 @@ public:
     ~Iec1ppmdsp (void);
 
     void process (float const *p, int n);
+    static void process4 (Iec1ppmdsp *m, float const * const *p, int n);
     float read (void);
     void reset ();
 
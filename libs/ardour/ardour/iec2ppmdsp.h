@@ -31,6 +31,7 @@ public:
     ~Iec2ppmdsp (void);
 
     void process (float const *p, int n);
+    static void process4 (Iec2ppmdsp *m, float const * const *p, int n);
     float read (void);
     void reset ();
 
@@ -25,6 +25,8 @@
 
 #include <stdint.h>
 
+#include "pbd/signals.h"
+
 #include "ardour/interthread_info.h"
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
@@ -33,12 +35,17 @@ namespace ARDOUR {
 
 class LIBARDOUR_API ImportStatus : public InterThreadInfo {
 public:
+	ImportStatus ()
+		: skip_unreadable (false)
+	{}
+
 	virtual ~ImportStatus() {
 		clear ();
 	}
 
 	virtual void clear () {
 		sources.clear ();
+		path_sources.clear ();
 		paths.clear ();
 	}
 
@@ -54,6 +61,8 @@ public:
 	bool                       split_midi_channels;
 	bool                       import_markers;
 	MidiTrackNameSource        midi_track_name_source;
+	/** continue with the next path if a file cannot be opened, rather than cancelling the import */
+	bool                       skip_unreadable;
 
 	/** set to true when all files have been imported, as distinct from the done in ARDOUR::InterThreadInfo,
 	 *  which indicates that one run of the import thread has been completed.
@@ -62,6 +71,13 @@ public:
 
 	/* result */
 	SourceList sources;
+	/** new sources for each of paths, empty if the file was skipped */
+	std::vector<SourceList> path_sources;
+
+	/** emitted by the import thread once an audio file of paths has been
+	 * converted (or the import was cancelled) and the file was closed.
+	 */
+	PBD::Signal<void(std::string)> InputFileDone;
 };
 
 } // namespace ARDOUR
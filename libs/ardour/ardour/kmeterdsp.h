@@ -31,6 +31,7 @@ public:
     ~Kmeterdsp (void);
 
     void process (float const *p, int n);
+    static void process4 (Kmeterdsp *m, float const * const *p, int n);
     float read ();
     void reset ();
 
@@ -38,6 +39,8 @@ public:
 
 private:
 
+    void store (float z1, float z2);
+
     float          _z1;          // filter state
     float          _z2;          // filter state
     float          _rms;         // max rms value since last read()
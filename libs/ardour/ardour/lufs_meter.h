@@ -19,15 +19,19 @@
 #define _lufs_meter_h_
 
 #include <cstdint>
-#include <functional>
-#include <map>
-
-#include "pbd/stack_allocator.h"
 
 #include "ardour/libardour_visibility.h"
 
+namespace AudioGrapher {
+	class LoudnessMeter;
+}
+
 namespace ARDOUR {
 
+/** Realtime loudness meter, a thin wrapper around
+ * AudioGrapher::LoudnessMeter which is also used for export
+ * and region analysis.
+ */
 class LIBARDOUR_API LUFSMeter
 {
 public:
@@ -44,60 +48,7 @@ public:
 	float dbtp () const;
 
 private:
-	void init ();
-
-	float process (float const** data, const uint32_t n_samples, uint32_t offset);
-	float sumfrag (uint32_t) const;
-
-	void  calc_true_peak (float const** data, const uint32_t n_samples);
-	float upsample_x4 (int chn, float const x);
-	float upsample_x2 (int chn, float const x);
-	std::function< float(int, const float) > upsample;
-
-	const float _g[5] = { 1.0, 1.0, 1.0, 1.41, 1.41 };
-
-	/* config */
-	double   _samplerate;
-	uint32_t _n_channels;
-	uint32_t _n_fragment;
-
-	/* filter coeff */
-	float _a0, _a1, _a2;
-	float _b1, _b2;
-	float _c3, _c4;
-
-	/* state */
-	uint32_t _frag_pos;
-	float    _frag_pwr;
-	uint32_t _block_cnt;
-	float    _block_pwr;
-	float    _power[8];
-	uint32_t _pow_idx;
-	float    _thresh_rel;
-
-	float    _momentary_l;
-
-	float    _maxloudn_M;
-	float    _integrated;
-	float    _dbtp;
-
-#if defined(_MSC_VER)
-	typedef std::map<int, uint32_t> History;
-#else
-	typedef std::map<int, uint32_t, std::less<int>, PBD::StackAllocator<std::pair<const int, uint32_t>, 1000>> History;
-#endif
-
-	History _hist;
-
-	struct FilterState {
-		void reset ();
-		void sanitize ();
-
-		float z1, z2, z3, z4;
-	};
-
-	FilterState _fst[5];
-	float*      _z[5];
+	AudioGrapher::LoudnessMeter* _meter;
 };
 
 } // namespace ARDOUR
@@ -108,10 +108,13 @@ private:
 	std::vector<float> _peak_power;      // includes accurate falloff, hence dB
 	std::vector<float> _max_peak_signal; // dB calculation is done on demand
 
-	std::vector<Kmeterdsp*>  _kmeter;
-	std::vector<Iec1ppmdsp*> _iec1meter;
-	std::vector<Iec2ppmdsp*> _iec2meter;
-	std::vector<Vumeterdsp*> _vumeter;
+	/* DSP meter state is kept contiguous per type, so that
+	 * consecutive channels can be processed in one SIMD pass.
+	 */
+	std::vector<Kmeterdsp>  _kmeter;
+	std::vector<Iec1ppmdsp> _iec1meter;
+	std::vector<Iec2ppmdsp> _iec2meter;
+	std::vector<Vumeterdsp> _vumeter;
 
 	MeterType _meter_type;
 };
@@ -62,6 +62,11 @@ public:
 
 	bool insert_event(const Evoral::Event<TimeType>& event);
 	bool merge_in_place(const MidiBuffer &other);
+	bool merge_in_place(const MidiBuffer &other, TimeType start, TimeType end);
+	bool merge_in_place(MidiBuffer const* const* others, size_t n_others);
+
+	/** Remove all events at or after the given time. Events must be sorted. */
+	void truncate (TimeType when);
 
 	/** EventSink interface for non-RT use (export, bounce). */
 	uint32_t write(TimeType time, Evoral::EventType type, uint32_t size, const uint8_t* buf);
@@ -210,7 +215,11 @@ private:
 #endif
 	}
 
-	uint8_t* _data; ///< [timestamp, event-type, event]*
+	struct MergeSource;
+	bool merge_sources (MergeSource*, size_t n_sources);
+
+	uint8_t* _data;    ///< [timestamp, event-type, event]*
+	uint8_t* _scratch; ///< merge target, swapped with _data
 	pframes_t _size;
 };
 
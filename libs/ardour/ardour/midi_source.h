@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <time.h>
 #include <glibmm/threads.h>
@@ -182,7 +183,16 @@ class LIBARDOUR_API MidiSource : virtual public Source
 
 	void set_note_mode(const WriterLock& lock, NoteMode mode);
 
-	std::shared_ptr<MidiModel> model() { return _model; }
+	/** Return the model, loading it from the file on first use if the
+	 * source was restored without one (see SMFSource).
+	 * This takes the source lock; it must not be called with the lock held.
+	 */
+	std::shared_ptr<MidiModel> model();
+	/** Return the model if it has been loaded, without loading it.
+	 * A deferred model is assigned before it is filled (see model()),
+	 * it is only returned once loading has completed.
+	 */
+	std::shared_ptr<MidiModel> loaded_model() const { return _model_deferred ? std::shared_ptr<MidiModel>() : _model; }
 	void set_model(const WriterLock& lock, std::shared_ptr<MidiModel>);
 	void drop_model(const WriterLock& lock);
 
@@ -227,6 +237,8 @@ class LIBARDOUR_API MidiSource : virtual public Source
 	                                  timecnt_t const &            cnt) = 0;
 
 	std::shared_ptr<MidiModel> _model;
+	/** true if the model is to be loaded by the first call to model() */
+	std::atomic<bool>            _model_deferred;
 	bool                         _writing;
 
 	/** The total duration of the current capture. */
@@ -50,6 +50,7 @@ namespace ARDOUR {
 class Session;
 class Route;
 class Plugin;
+class RTTaskList;
 
 /** Plugin inserts: send data through a plugin
  */
@@ -310,6 +311,7 @@ private:
 
 	bool _configured;
 	bool _no_inplace;
+	bool _parallel_inplace;
 	bool _strict_io;
 	bool _custom_cfg;
 	bool _maps_from_state;
@@ -355,9 +357,27 @@ private:
 	PinMappings _out_map;
 	ChanMapping _thru_map; // out-idx <=  in-idx
 
+	/* process replicated instances in parallel */
+	struct InstanceRunArgs {
+		BufferSet*         bufs;
+		PinMappings const* in_map;
+		samplepos_t        start;
+		samplepos_t        end;
+		double             speed;
+		pframes_t          nframes;
+		samplecnt_t        offset;
+	};
+
+	void run_instance (uint32_t pc);
+
+	std::shared_ptr<RTTaskList> _instance_tasks;
+	InstanceRunArgs             _instance_args;
+	std::atomic<int>            _instance_failed;
+
 	void automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t end, double speed, pframes_t nframes);
 	void connect_and_run (BufferSet& bufs, samplepos_t start, samplecnt_t end, double speed, pframes_t nframes, samplecnt_t offset, bool with_auto);
 	void bypass (BufferSet& bufs, pframes_t nframes);
+	bool sleep_on_silence (BufferSet& bufs, pframes_t nframes);
 	void inplace_silence_unconnected (BufferSet&, const PinMappings&, samplecnt_t nframes, samplecnt_t offset) const;
 
 	void create_automatable_parameters ();
@@ -369,6 +389,7 @@ private:
 
 	bool sanitize_maps ();
 	bool check_inplace ();
+	bool check_parallel_inplace () const;
 	void mapping_changed ();
 
 	void add_plugin (std::shared_ptr<Plugin>);
@@ -384,6 +405,9 @@ private:
 	uint32_t _bypass_port;
 	bool     _inverted_bypass_enable;
 
+	/* number of consecutive samples with silent input */
+	samplecnt_t _silent_samples;
+
 	typedef std::map<uint32_t, std::shared_ptr<ReadOnlyControl> >CtrlOutMap;
 	CtrlOutMap _control_outputs;
 
@@ -40,6 +40,7 @@ namespace ARDOUR {
 
 class PortEngine;
 class AudioBackend;
+class RTTaskList;
 class Session;
 
 class CircularSampleBuffer;
@@ -315,6 +316,7 @@ protected:
 
 private:
 	void run_input_meters (pframes_t, samplecnt_t);
+	std::shared_ptr<RTTaskList> queue_port_batches (void (Port::*) (pframes_t), pframes_t, Session*);
 	void set_pretty_names (std::vector<std::string> const&, DataType, bool);
 	void fill_midi_port_info_locked ();
 	void load_port_info ();
@@ -21,12 +21,18 @@
 
 #pragma once
 
+#include <vector>
+
 #include <samplerate.h>
 
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
 #include "ardour/importable_source.h"
 
+namespace ArdourZita {
+	class Resampler;
+}
+
 namespace ARDOUR {
 
 class LIBARDOUR_API ResampledImportableSource : public ImportableSource
@@ -52,12 +58,24 @@ class LIBARDOUR_API ResampledImportableSource : public ImportableSource
 	static const uint32_t blocksize;
 
    private:
+	bool        init_zita (samplecnt_t rate, unsigned int hlen);
+	samplecnt_t read_zita (Sample*, samplecnt_t);
+	bool        refill_zita ();
+
 	std::shared_ptr<ImportableSource> source;
 	float*          _input;
 	int             _src_type;
 	SRC_STATE*      _src_state;
 	SRC_DATA        _src_data;
 	bool            _end_of_input;
+
+	/* zita-resampler, one per channel (empty when using libsamplerate) */
+	std::vector<ArdourZita::Resampler*> _zita;
+	float*          _zita_in;  // de-interleaved input
+	float*          _zita_out; // de-interleaved output
+	bool            _zita_flushed;
+	samplecnt_t     _zita_in_total;
+	samplecnt_t     _zita_out_total;
 };
 
 }
@@ -19,10 +19,15 @@
 #ifndef _ardour_rt_task_h_
 #define _ardour_rt_task_h_
 
+#include <atomic>
 #include <functional>
 
 #include "ardour/graphnode.h"
 
+namespace PBD {
+	class Semaphore;
+}
+
 namespace ARDOUR
 {
 class Graph;
@@ -37,9 +42,12 @@ public:
 	void run (GraphChain const*);
 
 private:
+	friend class Graph;
 	friend class RTTaskList;
-	std::function<void ()> _f;
+	std::function<void ()>   _f;
 	Graph*                   _graph;
+	std::atomic<uint32_t>*   _pending; ///< set for nested tasks
+	PBD::Semaphore*          _done;    ///< set for nested tasks
 };
 
 }
@@ -21,6 +21,8 @@
 
 #include <vector>
 
+#include "pbd/semutils.h"
+
 #include "ardour/libardour_visibility.h"
 #include "ardour/rt_task.h"
 
@@ -33,7 +35,10 @@ class LIBARDOUR_API RTTaskList
 public:
 	RTTaskList (std::shared_ptr<Graph>);
 
-	/** process tasks in list in parallel, wait for them to complete */
+	/** process tasks in list in parallel, wait for them to complete.
+	 * This may be called by the main process-thread, or from
+	 * a graph-node while the graph is being processed.
+	 */
 	void process ();
 	void push_back (std::function<void ()> fn);
 
@@ -41,7 +46,9 @@ public:
 
 private:
 	std::vector<RTTask>      _tasks;
-	std::shared_ptr<Graph> _graph;
+	std::shared_ptr<Graph>   _graph;
+	std::atomic<uint32_t>    _n_pending;
+	PBD::Semaphore           _done; ///< signalled when the last nested task completes
 };
 
 } // namespace ARDOUR
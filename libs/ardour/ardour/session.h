@@ -111,6 +111,7 @@ namespace PBD {
 class Controllable;
 class Progress;
 class Command;
+class Thread;
 }
 
 namespace luabridge {
@@ -129,6 +130,7 @@ namespace ARDOUR {
 
 class Amp;
 class AsyncMIDIPort;
+class AnalysisFeatureCache;
 class AudioEngine;
 class AudioFileSource;
 class AudioRegion;
@@ -276,6 +278,9 @@ public:
 	std::string plugins_dir () const;     ///< Plugin state
 	std::string externals_dir () const;   ///< Links to external files
 
+	/** Cache of onset/transient analysis results, created on demand */
+	AnalysisFeatureCache& analysis_feature_cache ();
+
 	std::string construct_peak_filepath (const std::string& audio_path, const bool in_session = false, const bool old_peak_name = false) const;
 
 	bool audio_source_name_is_unique (const std::string& name);
@@ -359,6 +364,7 @@ public:
 	uint32_t nbusses () const;
 
 	bool plot_process_graph (std::string const& file_name) const;
+	std::shared_ptr<Graph> process_graph () const { return _process_graph; }
 
 	std::shared_ptr<BundleList const> bundles () {
 		return _bundles.reader ();
@@ -835,6 +841,10 @@ public:
 	unsigned int    get_xrun_count () const {return _xrun_count; }
 	void            reset_xrun_count ();
 
+	guint           get_event_pool_high_water () const { return SessionEvent::pool_high_water (); }
+	guint           get_event_pool_stall_count () const { return SessionEvent::pool_stall_count (); }
+	uint32_t        get_dropped_event_count () const { return dropped_event_count (); }
+
 	/* region info  */
 
 	std::shared_ptr<Region> find_whole_file_parent (std::shared_ptr<Region const>) const;
@@ -1098,6 +1108,8 @@ public:
 
 	uint32_t playback_load ();
 	uint32_t capture_load ();
+	/** lowest capture buffer load during the current or last take, in percent */
+	uint32_t capture_min_load ();
 
 	/* ranges */
 
@@ -1577,6 +1589,13 @@ private:
 
 	Glib::Threads::Mutex save_state_lock;
 	Glib::Threads::Mutex save_source_lock;
+	Glib::Threads::Mutex _pending_save_lock;
+	PBD::Thread*         _pending_save_thread;
+
+	AnalysisFeatureCache* _analysis_feature_cache;
+
+	void wait_for_pending_save ();
+	int  write_state_tree (XMLTree*, std::string const& tmp_path, std::string const& xml_path, std::string const& snapshot_name, bool pending);
 	Glib::Threads::Mutex peak_cleanup_lock;
 
 	int        load_options (const XMLNode&);
@@ -2070,6 +2089,7 @@ private:
 
 	mutable std::atomic<int> _playback_load;
 	mutable std::atomic<int> _capture_load;
+	mutable std::atomic<int> _capture_min_load;
 
 	/* I/O bundles */
 
@@ -21,12 +21,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <memory>
 
 
+#include "pbd/mpmc_queue.h"
 #include "pbd/pool.h"
-#include "pbd/ringbuffer.h"
 #include "pbd/event_loop.h"
 
 #include "ardour/libardour_visibility.h"
@@ -148,18 +149,29 @@ public:
 	static void init_event_pool ();
 	static guint pool_available ();
 
+	/** @return the largest number of events that were allocated at the same time from any thread's pool */
+	static guint pool_high_water () { return _pool_high_water.load (); }
+	/** @return the number of times a thread had to wait for events to be returned to its pool */
+	static guint pool_stall_count () { return _pool_stalls.load (); }
+	static void  note_pool_stall () { _pool_stalls.fetch_add (1); }
+	static void  reset_pool_stats ();
+
 	PBD::CrossThreadPool* event_pool() const { return own_pool; }
 
 private:
 	static PBD::PerThreadPool* pool;
 	PBD::CrossThreadPool*      own_pool;
 
+	static std::atomic<guint> _pool_high_water;
+	static std::atomic<guint> _pool_stalls;
+	static std::atomic<guint> _pool_stats_generation;
+
 	friend class Butler;
 };
 
 class SessionEventManager {
 public:
-	SessionEventManager () : pending_events (2048),
+	SessionEventManager () : pending_events (2048), _pending_events_dropped (0),
 	                         auto_loop_event(0), punch_out_event(0), punch_in_event(0) {}
 	virtual ~SessionEventManager() {}
 
@@ -167,15 +179,20 @@ public:
 	void clear_events (SessionEvent::Type type);
 	void clear_events (SessionEvent::Type type, std::function<void (void)> after);
 
+	/** @return number of events that were discarded because the queue to the process thread was full */
+	uint32_t dropped_event_count () const { return _pending_events_dropped.load (); }
+	void reset_event_stats ();
+
 protected:
-	PBD::RingBuffer<SessionEvent*> pending_events;
+	/* lock-free, bounded queue; written by any thread, read by the process thread */
+	PBD::MPMCQueue<SessionEvent*> pending_events;
+	std::atomic<uint32_t>         _pending_events_dropped;
+
 	typedef std::list<SessionEvent *> Events;
 	Events           events;
 	Events           immediate_events;
 	Events::iterator next_event;
 
-	Glib::Threads::Mutex rb_write_lock;
-
 	/* there can only ever be one of each of these */
 
 	SessionEvent *auto_loop_event;
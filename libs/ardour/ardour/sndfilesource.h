@@ -72,6 +72,9 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 
 	bool clamped_at_unity () const;
 
+	/** Reserve disk space ahead of the write position (capture files) */
+	void set_preallocate (bool yn) { _preallocate = yn; }
+
 	static const Source::Flag default_writable_flags;
 
 	static int get_soundfile_info (const std::string& path, SoundFileInfo& _info, std::string& error_msg);
@@ -91,7 +94,14 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 	SF_INFO _info;
 	BroadcastInfo *_broadcast_info;
 
+	/* capture file preallocation (see preallocate-capture-files) */
+	int   _fd;
+	off_t _preallocated;
+	bool  _preallocate;
+
 	void init_sndfile ();
+	void preallocate (samplepos_t end);
+	void release_preallocation ();
 	int open();
 	int setup_broadcast_info (samplepos_t when, struct tm&, time_t);
 	void file_closed ();
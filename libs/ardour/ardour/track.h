@@ -148,6 +148,7 @@ public:
 	void reset_write_sources ();
 	float playback_buffer_load () const;
 	float capture_buffer_load () const;
+	float capture_buffer_min_load () const;
 	int do_refill ();
 	int do_flush (RunContext, bool force = false);
 	void set_pending_overwrite (OverwriteReason);
@@ -678,7 +678,9 @@ enum SrcQuality {
 	SrcGood,
 	SrcQuick,
 	SrcFast,
-	SrcFastest
+	SrcFastest,
+	SrcZitaBest, ///< zita-resampler, falls back to SrcBest for unsupported ratios
+	SrcZitaGood
 };
 
 typedef std::list<samplepos_t> AnalysisFeatureList;
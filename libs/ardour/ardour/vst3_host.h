@@ -320,8 +320,8 @@ public:
 
 	Vst3ParamValueQueue ()
 	{
-		_values.reserve (maxNumPoints);
-		_id = Vst::kNoParamId;
+		_n_values = 0;
+		_id       = Vst::kNoParamId;
 	}
 
 	Vst::ParamID PLUGIN_API getParameterId () SMTG_OVERRIDE
@@ -331,13 +331,13 @@ public:
 
 	void setParameterId (Vst::ParamID id)
 	{
-		_values.clear ();
-		_id = id;
+		_n_values = 0;
+		_id       = id;
 	}
 
 	int32 PLUGIN_API getPointCount () SMTG_OVERRIDE
 	{
-		return _values.size ();
+		return _n_values;
 	}
 
 	tresult PLUGIN_API getPoint (int32 index, int32&, Vst::ParamValue&) SMTG_OVERRIDE;
@@ -345,6 +345,11 @@ public:
 
 protected:
 	struct Value {
+		Value ()
+			: value (0)
+			, sampleOffset (0)
+		{}
+
 		Value (Vst::ParamValue v, int32 offset)
 			: value (v)
 			, sampleOffset (offset)
@@ -354,8 +359,10 @@ protected:
 		int32           sampleOffset;
 	};
 
-	std::vector<Value> _values;
-	Vst::ParamID       _id;
+	/* fixed size, points are added in the rt-thread */
+	Value        _values[maxNumPoints];
+	int32        _n_values;
+	Vst::ParamID _id;
 };
 
 class LIBARDOUR_LOCAL Vst3ParameterChanges : public Vst::IParameterChanges
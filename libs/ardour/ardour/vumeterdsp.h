@@ -31,6 +31,7 @@ public:
     ~Vumeterdsp (void);
 
     void process (float const *p, int n);
+    static void process4 (Vumeterdsp *m, float const * const *p, int n);
     float read (void);
     void reset ();
 
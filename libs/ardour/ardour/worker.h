@@ -20,8 +20,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <stdint.h>
+#include <vector>
 
+#include <glibmm/threads.h>
+
+#include "pbd/microseconds.h"
+#include "pbd/mpmc_queue.h"
 #include "pbd/pthread_utils.h"
 #include "pbd/ringbuffer.h"
 #include "pbd/semutils.h"
@@ -31,6 +37,7 @@
 namespace ARDOUR {
 
 class Worker;
+class WorkerPool;
 
 /**
    An object that needs to schedule non-RT work in the audio thread.
@@ -53,9 +60,12 @@ public:
 /**
    A worker for non-realtime tasks scheduled from another thread.
 
-   A worker may be a separate thread that runs to execute scheduled work
-   asynchronously, or unthreaded, in which case work is executed immediately
-   upon scheduling by the calling thread.
+   A threaded worker executes scheduled work asynchronously using a
+   thread of the shared WorkerPool. Work of a given worker is never
+   processed concurrently, and requests are handled in the order
+   in which they were scheduled.
+   An unthreaded worker executes work immediately upon scheduling by the
+   calling thread.
 */
 class LIBARDOUR_API Worker
 {
@@ -91,7 +101,11 @@ public:
 	void set_synchronous(bool synchronous) { _synchronous = synchronous; }
 
 private:
-	void run();
+	friend class WorkerPool;
+
+	/** Process all queued requests (pool thread) */
+	void process_requests (WorkerPool&, std::vector<uint8_t>& buf);
+
 	/**
 	   Peek in RB, get size and check if a block of 'size' is available.
 
@@ -107,11 +121,71 @@ private:
 	PBD::RingBuffer<uint8_t>* _requests;
 	PBD::RingBuffer<uint8_t>* _responses;
 	uint8_t*                  _response;
-	PBD::Semaphore            _sem;
-	PBD::Thread*              _thread;
-	bool                      _exit;
+	WorkerPool*               _pool;
+	std::atomic<uint32_t>     _scheduled; ///< number of requests, not yet processed
+	std::atomic<bool>         _exit;
 	bool                      _synchronous;
 };
 
+/**
+   A bounded set of threads that executes work for all threaded Workers.
+
+   The pool is created when the first threaded Worker is instantiated, and
+   terminated when the last one is destroyed.
+*/
+class LIBARDOUR_API WorkerPool
+{
+public:
+	struct Stats {
+		uint32_t            n_threads;
+		uint32_t            n_workers;
+		uint32_t            queued;      ///< requests currently waiting to be processed
+		uint32_t            max_queued;  ///< max. number of requests waiting at any one time
+		uint64_t            processed;   ///< total number of processed requests
+		PBD::microseconds_t avg_latency; ///< average time from scheduling until work is done
+		PBD::microseconds_t max_latency;
+	};
+
+	/** @return false if there is currently no worker pool */
+	static bool get_stats (Stats&);
+	/** reset max. queue depth, request count and latencies */
+	static void reset_stats ();
+
+private:
+	friend class Worker;
+
+	WorkerPool ();
+	~WorkerPool ();
+
+	static WorkerPool* acquire ();
+	static void release ();
+
+	void scheduled ();
+	void enqueue (Worker*);
+	void done (PBD::microseconds_t scheduled_at);
+	void finished ();
+	void wait_for (Worker*);
+	void run ();
+
+	static Glib::Threads::Mutex _instance_lock;
+	static WorkerPool*          _instance;
+	static uint32_t             _n_workers;
+
+	PBD::MPMCQueue<Worker*>    _queue;
+	PBD::Semaphore             _sem;
+	std::vector<PBD::Thread*>  _threads;
+	std::atomic<bool>          _quit;
+
+	/* notify Worker d'tor when pending work is done */
+	Glib::Threads::Mutex       _finished_lock;
+	Glib::Threads::Cond        _finished_cond;
+
+	std::atomic<uint32_t>      _queued;
+	std::atomic<uint32_t>      _max_queued;
+	std::atomic<uint64_t>      _processed;
+	std::atomic<uint64_t>      _total_latency;
+	std::atomic<uint64_t>      _max_latency;
+};
+
 } // namespace ARDOUR
 
@@ -20,6 +20,7 @@
  */
 
 #include <cstring>
+#include <sstream>
 
 #include <vamp-hostsdk/PluginLoader.h>
 
@@ -101,6 +102,20 @@ AudioAnalyser::reset ()
 	}
 }
 
+std::string
+AudioAnalyser::parameter_key () const
+{
+	stringstream ss;
+	ss << plugin_key << '@' << sample_rate;
+	if (plugin) {
+		Plugin::ParameterList params = plugin->getParameterDescriptors ();
+		for (Plugin::ParameterList::const_iterator i = params.begin (); i != params.end (); ++i) {
+			ss << ';' << i->identifier << '=' << plugin->getParameter (i->identifier);
+		}
+	}
+	return ss.str ();
+}
+
 int
 AudioAnalyser::analyse (const string& path, AudioReadable* src, uint32_t channel)
 {
@@ -2271,32 +2271,67 @@ AudioRegion::find_silence (Sample threshold, samplecnt_t min_length, samplecnt_t
 	bool in_silence = true;
 	sampleoffset_t silence_start = start_sample();
 
-	while (pos < end && !itt.cancel) {
+	/* The peak-file stores min/max for every `fpp` samples, which
+	 * allows to classify a whole span of the source without reading
+	 * it: if the peak of a span is below the threshold, all of it is
+	 * silent. Audio data only needs to be read for spans containing
+	 * loud samples, to locate the exact silence boundaries.
+	 *
+	 * Moreover a silent period that lies entirely within a run of loud
+	 * spans can be at most 2 * fpp long. If that is too short to be
+	 * reported, only the first and last span of a loud run need to be
+	 * read.
+	 */
+	samplecnt_t const fpp = AudioSource::samples_per_file_peak ();
+	samplecnt_t const n_peaks = block_size / fpp;
+	bool const skip_loud_runs = min_length + 2 * fade_length + 1 >= 2 * fpp;
+	std::unique_ptr<PeakData[]> peaks (new PeakData[n_peaks]);
+	std::unique_ptr<Sample[]> peak_max (new Sample[n_peaks]);
 
+	assert (block_size % fpp == 0);
+
+	/* the span starting at spos is entirely silent */
+	auto silent_span = [&] (samplepos_t spos) {
+		if (!in_silence) {
+			/* non-silence to silence */
+			in_silence = true;
+			silence_start = spos + fade_length;
+		}
+	};
+
+	/* read [spos, spos + cnt) and locate silence boundaries in it */
+	auto scan_span = [&] (samplepos_t spos, samplecnt_t cnt) -> samplecnt_t {
 		samplecnt_t cur_samples = 0;
-		samplecnt_t const to_read = min (end - pos, block_size);
+		Sample peak = 0;
+
 		/* fill `loudest' with the loudest absolute sample at each instant, across all channels */
-		memset (loudest.get(), 0, sizeof (Sample) * block_size);
+		memset (loudest.get(), 0, sizeof (Sample) * cnt);
 
 		for (uint32_t n = 0; n < n_channels(); ++n) {
 
-			cur_samples = read_raw_internal (buf.get(), pos, to_read, n);
+			cur_samples = read_raw_internal (buf.get(), spos, cnt, n);
+			peak = compute_peak (buf.get(), cur_samples, peak);
 			for (samplecnt_t i = 0; i < cur_samples; ++i) {
 				loudest[i] = max (loudest[i], abs (buf[i]));
 			}
 		}
 
+		if (cur_samples > 0 && peak < threshold) {
+			silent_span (spos);
+			return cur_samples;
+		}
+
 		/* now look for silence */
 		for (samplecnt_t i = 0; i < cur_samples; ++i) {
 			bool const silence = abs (loudest[i]) < threshold;
 			if (silence && !in_silence) {
 				/* non-silence to silence */
 				in_silence = true;
-				silence_start = pos + i + fade_length;
+				silence_start = spos + i + fade_length;
 			} else if (!silence && in_silence) {
 				/* silence to non-silence */
 				in_silence = false;
-				sampleoffset_t silence_end = pos + i - 1 - fade_length;
+				sampleoffset_t silence_end = spos + i - 1 - fade_length;
 
 				if (silence_end - silence_start >= min_length) {
 					silent_periods.push_back (std::make_pair (silence_start, silence_end));
@@ -2304,6 +2339,72 @@ AudioRegion::find_silence (Sample threshold, samplecnt_t min_length, samplecnt_t
 			}
 		}
 
+		return cur_samples;
+	};
+
+	while (pos < end && !itt.cancel) {
+
+		/* keep blocks aligned to peak-file entries */
+		samplecnt_t const to_read = min (end - pos, block_size - (pos % block_size));
+
+		samplepos_t const p0 = ((pos + fpp - 1) / fpp) * fpp;
+		samplepos_t const p1 = ((pos + to_read) / fpp) * fpp;
+		samplecnt_t const np = p1 > p0 ? (p1 - p0) / fpp : 0;
+
+		bool have_peaks = np > 0;
+
+		for (uint32_t n = 0; n < n_channels() && have_peaks; ++n) {
+			have_peaks = audio_source (n)->read_file_peaks (peaks.get(), np, p0);
+			for (samplecnt_t k = 0; have_peaks && k < np; ++k) {
+				Sample const pk = max (fabsf (peaks[k].min), fabsf (peaks[k].max));
+				peak_max[k] = n > 0 ? max (peak_max[k], pk) : pk;
+			}
+		}
+
+		samplecnt_t cur_samples;
+
+		if (!have_peaks) {
+			cur_samples = scan_span (pos, to_read);
+		} else {
+			cur_samples = 0;
+
+			if (p0 > pos) {
+				cur_samples += scan_span (pos, p0 - pos);
+			}
+
+			for (samplecnt_t k = 0; k < np;) {
+				samplepos_t const kpos = p0 + k * fpp;
+				if (peak_max[k] < threshold) {
+					silent_span (kpos);
+					++k;
+					continue;
+				}
+
+				/* find the end of this run of loud spans */
+				samplecnt_t r = k + 1;
+				while (r < np && peak_max[r] >= threshold) {
+					++r;
+				}
+
+				if (skip_loud_runs && r - k > 2) {
+					scan_span (kpos, fpp);
+					/* there is a loud sample in the next span */
+					in_silence = false;
+					scan_span (p0 + (r - 1) * fpp, fpp);
+				} else {
+					scan_span (kpos, (r - k) * fpp);
+				}
+
+				k = r;
+			}
+
+			cur_samples += np * fpp;
+
+			if (pos + to_read > p1) {
+				cur_samples += scan_span (p1, pos + to_read - p1);
+			}
+		}
+
 		pos += cur_samples;
 		itt.progress = (end - pos) / (double) length_samples();
 
@@ -339,6 +339,37 @@ AudioSource::read_peaks (PeakData *peaks, samplecnt_t npeaks, samplepos_t start,
 	return read_peaks_with_fpp (peaks, npeaks, start, cnt, samples_per_visual_peak, _FPP);
 }
 
+samplecnt_t
+AudioSource::samples_per_file_peak ()
+{
+	return _FPP;
+}
+
+bool
+AudioSource::read_file_peaks (PeakData* peaks, samplecnt_t npeaks, samplepos_t start) const
+{
+	if ((_flags & NoPeakFile) || (start % _FPP) != 0 || npeaks <= 0) {
+		return false;
+	}
+
+	{
+		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
+		if (!_peaks_built) {
+			return false;
+		}
+	}
+
+	/* read_peaks() zero-fills past the end of the source, which would
+	 * be indistinguishable from actual silence.
+	 */
+	if (start + npeaks * _FPP > _length.samples ()) {
+		return false;
+	}
+
+	/* one visual peak per file peak: read_peaks() copies peak-file data */
+	return 0 == read_peaks (peaks, npeaks, start, npeaks * _FPP, _FPP);
+}
+
 /** @param peaks Buffer to write peak data.
  *  @param npeaks Number of peaks to write.
  */
@@ -738,6 +769,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 					 */
 
 					memset (raw_staging.get(), 0, sizeof (Sample) * chunksize);
+					samples_read = chunksize;
 
 				} else {
 
@@ -755,11 +787,17 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 				i = 0;
 			}
 
-			xmax = max (xmax, raw_staging[i]);
-			xmin = min (xmin, raw_staging[i]);
-			++i;
-			++current_sample;
-			pixel_pos += pixels_per_sample;
+			/* process all samples up to the next pixel boundary (or the end
+			 * of the staging buffer) at once, using the vectorized
+			 * peak-finder rather than comparing one sample at a time.
+			 */
+			samplecnt_t n = std::max<samplecnt_t> (1, ceil ((next_pixel_pos - pixel_pos) * samples_per_visual_peak));
+			n = std::min (n, samples_read - i);
+
+			find_peaks (&raw_staging[i], n, &xmin, &xmax);
+			i += n;
+			current_sample += n;
+			pixel_pos += n * pixels_per_sample;
 
 			if (pixel_pos >= next_pixel_pos) {
 
@@ -897,7 +935,13 @@ AudioSource::done_with_peakfile_writes (bool done)
 	}
 
 	if (peak_leftover_cnt) {
-		compute_and_write_peaks (0, 0, 0, true, false, _FPP);
+		/* compute the final (partial) peak from all remaining samples */
+		compute_and_write_peaks (0, peak_leftover_sample + peak_leftover_cnt, 0, false, false, _FPP);
+	}
+
+	if (done && -1 != _peakfile_fd) {
+		/* incremental writes pre-extend the file, see compute_and_write_peaks() */
+		truncate_peakfile ();
 	}
 
 	if (-1 != _peakfile_fd) {
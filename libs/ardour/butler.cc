@@ -366,7 +366,14 @@ Butler::thread_work ()
 bool
 Butler::flush_tracks_to_disk_normal (std::shared_ptr<RouteList const> rl, uint32_t& errors)
 {
-	bool disk_work_outstanding = false;
+	std::atomic<bool>     disk_work_outstanding (false);
+	std::atomic<uint32_t> n_errors (0);
+
+	/* write-behind is dispatched to the I/O thread-pool, so that
+	 * tracks recording to different disks (or a disk that benefits
+	 * from a deeper queue) are flushed concurrently.
+	 */
+	std::shared_ptr<IOTaskList> tl = _session.io_tasklist ();
 
 	for (RouteList::const_iterator i = rl->begin (); !transport_work_requested () && should_run && i != rl->end (); ++i) {
 		// cerr << "write behind for " << (*i)->name () << endl;
@@ -380,33 +387,37 @@ Butler::flush_tracks_to_disk_normal (std::shared_ptr<RouteList const> rl, uint32
 		/* note that we still try to flush diskstreams attached to inactive routes
 		 */
 
-		int ret;
-
-		// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler flushes track %1 capture load %2\n", tr->name(), tr->capture_buffer_load()));
-		ret = tr->do_flush (ButlerContext, false);
-		switch (ret) {
-			case 0:
-				//DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush complete for %1\n", tr->name()));
-				break;
-
-			case 1:
-				//DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush not finished for %1\n", tr->name()));
-				disk_work_outstanding = true;
-				break;
-
-			default:
-				errors++;
-				error << string_compose (_("Butler write-behind failure on dstream %1"), (*i)->name ()) << endmsg;
+		tl->push_back ([tr, &disk_work_outstanding, &n_errors]() {
+			// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler flushes track %1 capture load %2\n", tr->name(), tr->capture_buffer_load()));
+			switch (tr->do_flush (ButlerContext, false)) {
+				case 0:
+					//DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush complete for %1\n", tr->name()));
+					break;
+
+				case 1:
+					//DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush not finished for %1\n", tr->name()));
+					disk_work_outstanding = true;
+					break;
+
+				default:
+					n_errors.fetch_add (1);
+					error << string_compose (_("Butler write-behind failure on dstream %1"), tr->name ()) << endmsg;
 #ifndef NDEBUG
-				std::cerr << string_compose (_("Butler write-behind failure on dstream %1"), (*i)->name ()) << std::endl;
+					std::cerr << string_compose (_("Butler write-behind failure on dstream %1"), tr->name ()) << std::endl;
 #endif
-				/* don't break - try to flush all streams in case they
-			   are split across disks.
-			*/
-		}
+					/* don't break - try to flush all streams in case they
+					 * are split across disks.
+					 */
+					break;
+			}
+		});
 	}
 
-	return disk_work_outstanding;
+	tl->process ();
+	tl.reset ();
+
+	errors += n_errors.load ();
+	return disk_work_outstanding.load ();
 }
 
 void
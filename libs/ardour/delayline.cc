@@ -18,6 +18,7 @@
 
 #include <assert.h>
 #include <cmath>
+#include <limits>
 
 #include "pbd/compose.h"
 
@@ -255,14 +256,8 @@ DelayLine::run (BufferSet& bufs, samplepos_t /* start_sample */, samplepos_t /*
 			/* move events from dly-buffer into current-buffer until n_samples
 			 * and remove them from the dly-buffer
 			 */
-			for (MidiBuffer::iterator m = dly->begin (); m != dly->end ();) {
-				const Evoral::Event<MidiBuffer::TimeType> ev (*m, false);
-				if (ev.time () >= n_samples) {
-					break;
-				}
-				mb.insert_event (ev);
-				m = dly->erase (m);
-			}
+			mb.merge_in_place (*dly, 0, n_samples);
+			dly->silence (n_samples);
 
 			/* For now, this is only relevant if there is there's a positive delay.
 			 * In the future this could also be used to delay 'too early' events
@@ -272,19 +267,8 @@ DelayLine::run (BufferSet& bufs, samplepos_t /* start_sample */, samplepos_t /*
 				/* move events after n_samples from current-buffer into dly-buffer
 				 * and trim current-buffer after n_samples
 				 */
-				for (MidiBuffer::iterator m = mb.begin (); m != mb.end ();) {
-					const Evoral::Event<MidiBuffer::TimeType> ev (*m, false);
-					if (ev.time () < n_samples) {
-						++m;
-						continue;
-					}
-					/* insert_event() is expensive, if delay_diff is zero, the
-					 * event must be later than the last event in the delay-buffer
-					 * and push_back() would be preferable.
-					 */
-					dly->insert_event (ev);
-					m = mb.erase (m);
-				}
+				dly->merge_in_place (mb, n_samples, std::numeric_limits<MidiBuffer::TimeType>::max ());
+				mb.truncate (n_samples);
 			}
 		}
 	}
@@ -36,6 +36,7 @@
 #include "ardour/region_factory.h"
 #include "ardour/session.h"
 #include "ardour/smf_source.h"
+#include "ardour/sndfilesource.h"
 
 #include "pbd/atomic.h"
 #include "pbd/i18n.h"
@@ -69,6 +70,7 @@ DiskWriter::DiskWriter (Session& s, Track& t, string const & str, DiskIOProcesso
 	_record_safe.store (0);
 	_samples_pending_write.store (0);
 	_num_captured_loops.store (0);
+	_min_buffer_load.store (1.f);
 }
 
 DiskWriter::~DiskWriter ()
@@ -873,6 +875,7 @@ DiskWriter::prep_record_enable ()
 	std::shared_ptr<ChannelList const> c = channels.reader();
 
 	capturing_sources.clear ();
+	reset_min_buffer_load ();
 
 	for (auto const& chan : *c) {
 		capturing_sources.push_back (chan->write_source);
@@ -959,6 +962,13 @@ DiskWriter::do_flush (RunContext ctxt, bool force_flush)
 	vector.buf[1] = 0;
 
 	std::shared_ptr<ChannelList const> c = channels.reader();
+
+	if (!c->empty ()) {
+		float load = buffer_load ();
+		float min_load = _min_buffer_load.load ();
+		while (load < min_load && !_min_buffer_load.compare_exchange_weak (min_load, load)) ;
+	}
+
 	for (auto const& chan : *c) {
 
 		chan->wbuf->get_read_vector (&vector);
@@ -1157,6 +1167,11 @@ DiskWriter::use_new_write_source (DataType dt, uint32_t n)
 		}
 
 		chan->write_source->set_allow_remove_if_empty (true);
+
+		std::shared_ptr<SndFileSource> sfs = std::dynamic_pointer_cast<SndFileSource> (chan->write_source);
+		if (sfs) {
+			sfs->set_preallocate (Config->get_preallocate_capture_files ());
+		}
 	}
 
 	return 0;
@@ -1236,6 +1251,10 @@ DiskWriter::transport_stopped_wallclock (struct tm& when, time_t twhen, bool abo
 
 		if (as) {
 			audio_srcs.push_back (as);
+			/* peaks were computed while writing, flush the last
+			 * partial peak and mark them as complete.
+			 */
+			as->done_with_peakfile_writes ();
 			as->update_header (capture_info.front()->start, when, twhen);
 			as->set_captured_for (_track.name());
 			as->mark_immutable ();
@@ -19,19 +19,19 @@
 
 #include <cmath>
 #include <cstring>
+#include <vector>
+
+#include "audiographer/general/loudness_meter.h"
 
 #include "ardour/ebur128_analysis.h"
 
 #include "pbd/i18n.h"
 
-using namespace Vamp;
 using namespace ARDOUR;
 using namespace std;
 
-/* need a static initializer function for this */
-
 EBUr128Analysis::EBUr128Analysis (float sr)
-	: AudioAnalyser (sr, X_("libardourvampplugins:ebur128"))
+	: _sample_rate (sr)
 	, _loudness (0)
 	, _loudness_range (0)
 {
@@ -44,71 +44,37 @@ EBUr128Analysis::~EBUr128Analysis()
 int
 EBUr128Analysis::run (AudioReadable* src)
 {
-	int ret = -1;
-	bool done = false;
 	samplecnt_t len = src->readable_length_samples();
 	samplepos_t pos = 0;
+	samplecnt_t const bufsize = 8192;
 	uint32_t n_channels = src->n_channels();
-	Plugin::FeatureSet features;
 
-	plugin->reset ();
-	if (!plugin->initialise (n_channels, stepsize, bufsize)) {
+	if (n_channels == 0) {
 		return -1;
 	}
 
-	float** bufs = (float**) malloc(n_channels * sizeof(float*));
-	for (uint32_t c = 0; c < n_channels; ++c) {
-		bufs[c] = (float*) malloc(bufsize * sizeof(float));
-	}
+	/* loudness only, true-peak is not needed here */
+	AudioGrapher::LoudnessMeter meter (_sample_rate, n_channels, false);
 
-	while (!done) {
-		samplecnt_t to_read;
-		to_read = min ((len - pos), (samplecnt_t) bufsize);
+	vector<vector<float> > bufs (n_channels, vector<float> (bufsize));
+	vector<float const*>   ptrs (n_channels);
+
+	while (pos < len) {
+		samplecnt_t to_read = min ((len - pos), bufsize);
 
 		for (uint32_t c = 0; c < n_channels; ++c) {
-			if (src->read (bufs[c], pos, to_read, c) != to_read) {
-				goto out;
-			}
-			/* zero fill buffer if necessary */
-			if (to_read != bufsize) {
-				memset (bufs[c] + to_read, 0, (bufsize - to_read) * sizeof (float));
+			if (src->read (&bufs[c][0], pos, to_read, c) != to_read) {
+				return -1;
 			}
+			ptrs[c] = &bufs[c][0];
 		}
 
-		plugin->process (bufs, RealTime::fromSeconds ((double) pos / sample_rate));
-
-		pos += min (stepsize, to_read);
-
-		if (pos >= len) {
-			done = true;
-		}
+		meter.process (&ptrs[0], to_read);
+		pos += to_read;
 	}
 
-	features = plugin->getRemainingFeatures ();
-
-	if (use_features (features, 0)) {
-		goto out;
-	}
-
-	ret = 0;
-
-out:
-	for (uint32_t c = 0; c < n_channels; ++c) {
-		free (bufs[c]);
-	}
-	free (bufs);
-
-	return ret;
-}
-
-int
-EBUr128Analysis::use_features (Plugin::FeatureSet& features, ostream* out)
-{
-	if (features.empty() || features.size() != 2) {
-		return 0;
-	}
-	_loudness = features[0][0].values[0];
-	_loudness_range = features[1][0].values[0];
+	_loudness       = meter.integrated ();
+	_loudness_range = meter.loudness_range ();
 
 	return 0;
 }
@@ -719,6 +719,9 @@ setup_enum_writer ()
 	REGISTER_CLASS_ENUM (ExportFormatBase, SRC_SincFast);
 	REGISTER_CLASS_ENUM (ExportFormatBase, SRC_ZeroOrderHold);
 	REGISTER_CLASS_ENUM (ExportFormatBase, SRC_Linear);
+	REGISTER_CLASS_ENUM (ExportFormatBase, SRC_ZitaBest);
+	REGISTER_CLASS_ENUM (ExportFormatBase, SRC_ZitaMedium);
+	REGISTER_CLASS_ENUM (ExportFormatBase, SRC_ZitaFast);
 	REGISTER (_ExportFormatBase_SRCQuality);
 
 	REGISTER_CLASS_ENUM (ExportProfileManager, Timecode);
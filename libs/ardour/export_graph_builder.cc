@@ -50,6 +50,7 @@
 #include "audiographer/general/silence_trimmer.h"
 #include "audiographer/general/threader.h"
 #include "audiographer/sndfile/tmp_file.h"
+#include "audiographer/sndfile/tmp_file_mem.h"
 #include "audiographer/sndfile/tmp_file_rt.h"
 #include "audiographer/sndfile/tmp_file_sync.h"
 #include "audiographer/sndfile/sndfile_writer.h"
@@ -157,6 +158,7 @@ namespace ARDOUR {
 
 ExportGraphBuilder::ExportGraphBuilder (Session const & session)
 	: session (session)
+	, _tmp_memory_used (0)
 	, thread_pool (hardware_concurrency())
 {
 	process_buffer_samples = session.engine().samples_per_cycle();
@@ -166,38 +168,69 @@ ExportGraphBuilder::~ExportGraphBuilder ()
 {
 }
 
+/** Process one cycle starting at timeline position \a position.
+ * Each timespan receives the part of the cycle that it covers.
+ */
 samplecnt_t
-ExportGraphBuilder::process (samplecnt_t samples, bool last_cycle)
+ExportGraphBuilder::process (samplepos_t position, samplecnt_t samples)
 {
 	assert(samples <= process_buffer_samples);
 
+	if (channel_buffers.empty ()) {
+		return samples;
+	}
+
+	for (auto& cb : channel_buffers) {
+		cb.first->read (cb.second, samples);
+	}
+
+	if (session.remaining_latency_preroll () >= _master_align + samples) {
+		/* Skip processing during pre-roll, only read/write export ringbuffers */
+		return 0;
+	}
+
 	sampleoffset_t off = 0;
-	for (ChannelMap::iterator it = channels.begin(); it != channels.end(); ++it) {
-		Buffer const* buf;
-		it->first->read (buf, samples);
+	if (session.remaining_latency_preroll () > _master_align) {
+		off = session.remaining_latency_preroll () - _master_align;
+		assert (off < samples);
+	}
 
-		if (session.remaining_latency_preroll () >= _master_align + samples) {
-			/* Skip processing during pre-roll, only read/write export ringbuffers */
-			return 0;
-		}
+	samplepos_t const end = position + samples - off;
 
-		off = 0;
-		if (session.remaining_latency_preroll () > _master_align) {
-			off = session.remaining_latency_preroll () - _master_align;
-			assert (off < samples);
+	for (auto& ts : timespans) {
+		if (ts.second.finished) {
+			continue;
 		}
 
-		AudioBuffer const* ab = dynamic_cast<AudioBuffer const*> (buf);
-		MidiBuffer const*  mb;
-		if (ab) {
-			Sample const* process_buffer = ab->data ();
-			ConstProcessContext<Sample> context(&process_buffer[off], samples - off, 1);
-			if (last_cycle) { context().set_flag (ProcessContext<Sample>::EndOfInput); }
-			it->second->process (context);
+		samplepos_t const ts_end     = ts.first->get_end ();
+		bool const        last_cycle = position + samples >= ts_end;
+		samplepos_t const s0         = std::min (end, std::max (position, ts.first->get_start ()));
+		samplepos_t const s1         = std::max (s0, std::min (end, ts_end));
+
+		if (s0 == s1 && !last_cycle) {
+			/* timespan starts later */
+			continue;
 		}
-		if  ((mb = dynamic_cast<MidiBuffer const*> (buf))) {
-			it->second->process (*mb, off, samples - off, last_cycle);
+
+		sampleoffset_t const ts_off = off + s0 - position;
+		samplecnt_t const    ts_cnt = s1 - s0;
+
+		for (ChannelMap::iterator it = ts.second.channels.begin(); it != ts.second.channels.end(); ++it) {
+			Buffer const* buf = channel_buffers[it->first];
+			AudioBuffer const* ab = dynamic_cast<AudioBuffer const*> (buf);
+			MidiBuffer const*  mb;
+			if (ab) {
+				Sample const* process_buffer = ab->data ();
+				ConstProcessContext<Sample> context(&process_buffer[ts_off], ts_cnt, 1);
+				if (last_cycle) { context().set_flag (ProcessContext<Sample>::EndOfInput); }
+				it->second->process (context);
+			}
+			if  ((mb = dynamic_cast<MidiBuffer const*> (buf))) {
+				it->second->process (*mb, ts_off, ts_cnt, last_cycle);
+			}
 		}
+
+		ts.second.finished = last_cycle;
 	}
 
 	return samples - off;
@@ -232,12 +265,14 @@ ExportGraphBuilder::reset ()
 {
 	timespan.reset();
 	channel_configs.clear ();
-	channels.clear ();
+	timespans.clear ();
+	channel_buffers.clear ();
 	intermediates.clear ();
 	analysis_map.clear();
 	_exported_files.clear();
 	_realtime = false;
 	_master_align = 0;
+	_tmp_memory_used = 0;
 }
 
 void
@@ -257,6 +292,18 @@ ExportGraphBuilder::set_current_timespan (std::shared_ptr<ExportTimespan> span)
 	timespan = span;
 }
 
+std::vector<std::string>
+ExportGraphBuilder::exported_files (std::shared_ptr<ExportTimespan> span) const
+{
+	std::vector<std::string> files;
+	for (auto const& f : _exported_files) {
+		if (f.first == span) {
+			files.push_back (f.second);
+		}
+	}
+	return files;
+}
+
 void
 ExportGraphBuilder::add_config (FileSpec const & config, bool rt)
 {
@@ -337,7 +384,7 @@ ExportGraphBuilder::add_split_config (FileSpec const & config)
 	}
 
 	// No duplicate channel config found, create new one
-	channel_configs.push_back (new ChannelConfig (*this, config, channels));
+	channel_configs.push_back (new ChannelConfig (*this, config, timespans[timespan].channels));
 }
 
 /* Encoder */
@@ -785,7 +832,10 @@ ExportGraphBuilder::Intermediate::Intermediate (ExportGraphBuilder & parent, Fil
 
 	config = new_config;
 	uint32_t const channels = config.channel_config->get_n_chans();
-	max_samples_out = 4086 - (4086 % channels); // TODO good chunk size
+	/* chunk size for post-processing, when the data is read back. Use
+	 * large reads, there is no realtime constraint at this point.
+	 */
+	max_samples_out = 16384 - (16384 % channels);
 
 	buffer.reset (new AllocatingProcessContext<Sample> (max_samples_out, channels));
 
@@ -795,8 +845,25 @@ ExportGraphBuilder::Intermediate::Intermediate (ExportGraphBuilder & parent, Fil
 
 	int format = ExportFormatBase::F_RAW | ExportFormatBase::SF_Float;
 
+	/* Estimate the size of the data, and keep it in memory if it fits
+	 * into what is left of the budget. This avoids writing and reading
+	 * back all the data when normalizing.
+	 *
+	 * Realtime export writes from the process-thread, memory cannot be
+	 * allocated there. It uses a ringbuffer and a disk-writer thread.
+	 */
+	samplecnt_t const session_rate = parent.session.nominal_sample_rate();
+	samplecnt_t const sb = config.format->silence_beginning_at (parent.timespan->get_start(), session_rate);
+	samplecnt_t const se = config.format->silence_end_at (parent.timespan->get_end(), session_rate);
+	double const      duration = (parent.timespan->get_length () + sb + se) * (double) config.format->sample_rate() / session_rate;
+	/* allow for SRC delay and rounding */
+	size_t const      estimate = (duration * 1.01 + max_samples_out) * channels * sizeof (float);
+
 	if (parent._realtime) {
 		tmp_file.reset (new TmpFileRt<float> (&tmpfile_path_buf[0], format, channels, config.format->sample_rate()));
+	} else if (parent._tmp_memory_used + estimate <= max_tmp_memory) {
+		parent._tmp_memory_used += estimate;
+		tmp_file.reset (new TmpFileMem<float> (estimate, format, channels, config.format->sample_rate()));
 	} else {
 		tmp_file.reset (new TmpFileSync<float> (&tmpfile_path_buf[0], format, channels, config.format->sample_rate()));
 	}
@@ -1067,6 +1134,7 @@ ExportGraphBuilder::SilenceHandler::operator== (FileSpec const & other_config) c
 
 ExportGraphBuilder::ChannelConfig::ChannelConfig (ExportGraphBuilder & parent, FileSpec const & new_config, ChannelMap & channel_map)
 	: parent (parent)
+	, timespan (parent.timespan)
 {
 	typedef ExportChannelConfiguration::ChannelList ChannelList;
 
@@ -1095,6 +1163,7 @@ ExportGraphBuilder::ChannelConfig::ChannelConfig (ExportGraphBuilder & parent, F
 				channel_map.insert (std::make_pair (*it, AnyExportPtr (new AnyExport ())));
 			assert (result_pair.second);
 			map_it = result_pair.first;
+			parent.channel_buffers.insert (std::make_pair (*it, (Buffer const*) 0));
 		}
 		if ((*it)->midi ()) {
 			config.filename->set_channel_config(config.channel_config);
@@ -1148,7 +1217,7 @@ ExportGraphBuilder::ChannelConfig::remove_children (bool remove_out_files)
 bool
 ExportGraphBuilder::ChannelConfig::operator== (FileSpec const & other_config) const
 {
-	return config.channel_config == other_config.channel_config;
+	return timespan == parent.timespan && config.channel_config == other_config.channel_config;
 }
 
 } // namespace ARDOUR
@@ -22,6 +22,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+
 #include "pbd/gstdio_compat.h"
 #include <glibmm.h>
 #include <glibmm/convert.h>
@@ -206,13 +208,23 @@ ExportHandler::do_export ()
 	export_status->init();
 	std::set<ExportTimespanPtr> timespan_set;
 	for (ConfigMap::iterator it = config_map.begin(); it != config_map.end(); ++it) {
-		bool new_timespan = timespan_set.insert (it->first).second;
-		if (new_timespan) {
-			export_status->total_samples += it->first->get_length();
-		}
+		timespan_set.insert (it->first);
 	}
 	export_status->total_timespans = timespan_set.size();
 
+	/* Overlapping timespans are rendered in a single pass,
+	 * progress is relative to the total duration of all passes.
+	 */
+	while (!timespan_set.empty ()) {
+		std::vector<ExportTimespanPtr> pass;
+		samplepos_t start, end;
+		plan_pass (timespan_set, pass, start, end);
+		export_status->total_samples += end - start;
+		for (auto const& ts : pass) {
+			timespan_set.erase (ts);
+		}
+	}
+
 	if (export_status->total_timespans > 1) {
 		// always include timespan if there's more than one.
 		for (ConfigMap::iterator it = config_map.begin(); it != config_map.end(); ++it) {
@@ -245,38 +257,47 @@ ExportHandler::start_timespan ()
 		return -1;
 	}
 
-	export_status->timespan++;
+	/* finish_timespan pops the config_map entries that have been done,
+	 * collect the timespans that can be done in this pass.
+	 */
+	std::set<ExportTimespanPtr> pending;
+	for (ConfigMap::iterator it = config_map.begin(); it != config_map.end(); ++it) {
+		pending.insert (it->first);
+	}
 
-	/* finish_timespan pops the config_map entry that has been done, so
-	   this is the timespan to do this time
-	*/
-	current_timespan = config_map.begin()->first;
+	samplepos_t start;
+	plan_pass (pending, current_timespans, start, current_end);
+	current_timespan = current_timespans.front ();
 
-	export_status->total_samples_current_timespan = current_timespan->get_length();
+	export_status->timespan += current_timespans.size ();
+	export_status->total_samples_current_timespan = current_end - start;
 	export_status->timespan_name = current_timespan->name();
 	export_status->processed_samples_current_timespan = 0;
 
 	/* Register file configurations to graph builder */
 
-	/* Here's the config_map entries that use this timespan */
-	timespan_bounds = config_map.equal_range (current_timespan);
 	graph_builder->reset ();
-	graph_builder->set_current_timespan (current_timespan);
-	handle_duplicate_format_extensions();
 	bool realtime = current_timespan->realtime ();
 	bool region_export = true;
-	for (ConfigMap::iterator it = timespan_bounds.first; it != timespan_bounds.second; ++it) {
-		// Filenames can be shared across timespans
-		FileSpec & spec = it->second;
-		spec.filename->set_timespan (it->first);
-		switch (spec.channel_config->region_processing_type ()) {
-			case RegionExportChannelFactory::None:
-				region_export = false;
-				break;
-			default:
-				break;
+
+	for (auto const& ts : current_timespans) {
+		/* Here's the config_map entries that use this timespan */
+		timespan_bounds = config_map.equal_range (ts);
+		graph_builder->set_current_timespan (ts);
+		handle_duplicate_format_extensions();
+		for (ConfigMap::iterator it = timespan_bounds.first; it != timespan_bounds.second; ++it) {
+			// Filenames can be shared across timespans
+			FileSpec & spec = it->second;
+			spec.filename->set_timespan (it->first);
+			switch (spec.channel_config->region_processing_type ()) {
+				case RegionExportChannelFactory::None:
+					region_export = false;
+					break;
+				default:
+					break;
+			}
+			graph_builder->add_config (spec, realtime);
 		}
-		graph_builder->add_config (spec, realtime);
 	}
 
 	// ExportDialog::update_realtime_selection does not allow this
@@ -286,7 +307,7 @@ ExportHandler::start_timespan ()
 
 	post_processing = false;
 	session.ProcessExport.connect_same_thread (process_connection, std::bind (&ExportHandler::process, this, _1));
-	process_position = current_timespan->get_start();
+	process_position = start;
 
 	if (!region_export && !current_timespan->vapor ().empty () && session.surround_master ()) {
 		session.surround_master ()->surround_return ()->setup_export (current_timespan->vapor (), current_timespan->get_start (), current_timespan->get_end ());
@@ -331,6 +352,66 @@ ExportHandler::handle_duplicate_format_extensions()
 	}
 }
 
+/** Timespans that are exported with plain (non-realtime) freewheeling
+ * can share a pass with other timespans. Realtime, region and surround
+ * (vapor) exports each need a dedicated pass.
+ */
+bool
+ExportHandler::can_share_pass (ExportTimespanPtr ts) const
+{
+	if (ts->realtime () || !ts->vapor ().empty ()) {
+		return false;
+	}
+
+	std::pair<ConfigMap::const_iterator, ConfigMap::const_iterator> bounds = config_map.equal_range (ts);
+	for (ConfigMap::const_iterator it = bounds.first; it != bounds.second; ++it) {
+		if (it->second.channel_config->region_processing_type () != RegionExportChannelFactory::None) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/** Collect timespans that can be rendered in a single freewheel pass,
+ * starting with the first \a pending timespan, and adding all that
+ * overlap or adjoin the range [\a start, \a end) covered so far.
+ * This way the session is processed only once for e.g. stems of
+ * several ranges, or back-to-back ranges of an album.
+ */
+void
+ExportHandler::plan_pass (std::set<ExportTimespanPtr> const& pending, std::vector<ExportTimespanPtr>& pass, samplepos_t& start, samplepos_t& end) const
+{
+	assert (!pending.empty ());
+
+	ExportTimespanPtr first = *pending.begin ();
+
+	pass.clear ();
+	pass.push_back (first);
+	start = first->get_start ();
+	end   = first->get_end ();
+
+	if (!can_share_pass (first)) {
+		return;
+	}
+
+	bool added;
+	do {
+		added = false;
+		for (auto const& ts : pending) {
+			if (std::find (pass.begin (), pass.end (), ts) != pass.end ()) {
+				continue;
+			}
+			if (ts->get_start () > end || ts->get_end () < start || !can_share_pass (ts)) {
+				continue;
+			}
+			pass.push_back (ts);
+			start = std::min (start, ts->get_start ());
+			end   = std::max (end, ts->get_end ());
+			added = true;
+		}
+	} while (added);
+}
+
 int
 ExportHandler::process (samplecnt_t samples)
 {
@@ -358,7 +439,7 @@ ExportHandler::process_timespan (samplecnt_t samples)
 	/* update position */
 
 	samplecnt_t samples_to_read = 0;
-	samplepos_t const end = current_timespan->get_end();
+	samplepos_t const end = current_end;
 
 	if (process_position >= end) {
 		/* export complete, post-roll to feed and flush latent plugins
@@ -390,7 +471,7 @@ ExportHandler::process_timespan (samplecnt_t samples)
 	}
 
 	/* Do actual processing */
-	samplecnt_t ret = graph_builder->process (samples_to_read, last_cycle);
+	samplecnt_t ret = graph_builder->process (process_position, samples_to_read);
 	if (ret > 0) {
 		process_position += ret;
 		export_status->processed_samples += ret;
@@ -439,143 +520,152 @@ ExportHandler::finish_timespan ()
 	 * for a single config, config_map iterator below does not yet
 	 * take that into account.
 	 */
-	for (auto const& f : graph_builder->exported_files ()) {
-		Session::Exported (current_timespan->name(), f, config_map.begin()->second.format->reimport(), current_timespan->get_start ()); /* EMIT SIGNAL */
+	for (auto const& ts : current_timespans) {
+		bool const reimport = config_map.find (ts)->second.format->reimport ();
+		for (auto const& f : graph_builder->exported_files (ts)) {
+			Session::Exported (ts->name(), f, reimport, ts->get_start ()); /* EMIT SIGNAL */
+		}
 	}
 
-	while (config_map.begin() != timespan_bounds.second) {
+	for (auto const& ts : current_timespans) {
+		current_timespan = ts;
+		timespan_bounds = config_map.equal_range (ts);
 
-		// XXX single timespan+format may produce multiple files
-		// e.g export selection == session
-		// -> TagLib::FileRef is null
+		while (timespan_bounds.first != timespan_bounds.second) {
 
-		FileSpec& config = config_map.begin()->second;
-		ExportFormatSpecPtr fmt = config.format;
-		config.filename->set_channel_config (config.channel_config);
-		std::string filename = config.filename->get_path (fmt);
+			// XXX single timespan+format may produce multiple files
+			// e.g export selection == session
+			// -> TagLib::FileRef is null
 
-		if (fmt->type () == ExportFormatBase::T_None) {
-			graph_builder->reset ();
-			config_map.erase (config_map.begin());
-			continue;
-		}
+			FileSpec& config = timespan_bounds.first->second;
+			ExportFormatSpecPtr fmt = config.format;
+			config.filename->set_timespan (current_timespan);
+			config.filename->set_channel_config (config.channel_config);
+			std::string filename = config.filename->get_path (fmt);
 
-		if (fmt->with_cue()) {
-			export_cd_marker_file (current_timespan, fmt, filename, CDMarkerCUE);
-		}
+			if (fmt->type () == ExportFormatBase::T_None) {
+				graph_builder->reset ();
+				config_map.erase (timespan_bounds.first++);
+				continue;
+			}
 
-		if (fmt->with_toc()) {
-			export_cd_marker_file (current_timespan, fmt, filename, CDMarkerTOC);
-		}
+			if (fmt->with_cue()) {
+				export_cd_marker_file (current_timespan, fmt, filename, CDMarkerCUE);
+			}
 
-		if (fmt->with_mp4chaps()) {
-			export_cd_marker_file (current_timespan, fmt, filename, MP4Chaps);
-		}
+			if (fmt->with_toc()) {
+				export_cd_marker_file (current_timespan, fmt, filename, CDMarkerTOC);
+			}
 
-		/* close file first, otherwise TagLib enounters an ERROR_SHARING_VIOLATION
-		 * The process cannot access the file because it is being used.
-		 * ditto for post-export and upload.
-		 */
-		graph_builder->reset ();
+			if (fmt->with_mp4chaps()) {
+				export_cd_marker_file (current_timespan, fmt, filename, MP4Chaps);
+			}
 
-		if (fmt->tag()) {
-			/* TODO: check Umlauts and encoding in filename.
-			 * TagLib eventually calls CreateFileA(),
+			/* close file first, otherwise TagLib enounters an ERROR_SHARING_VIOLATION
+			 * The process cannot access the file because it is being used.
+			 * ditto for post-export and upload.
 			 */
-			export_status->active_job = ExportStatus::Tagging;
-			AudiofileTagger::tag_file(filename, *SessionMetadata::Metadata());
-		}
+			graph_builder->reset ();
 
-		if (!fmt->command().empty()) {
-			SessionMetadata const & metadata (*SessionMetadata::Metadata());
-
-			export_status->active_job = ExportStatus::Command;
-			PBD::ScopedConnection command_connection;
-
-			std::stringstream track_number;
-			track_number << metadata.track_number ();
-			std::stringstream total_tracks;
-			total_tracks << metadata.total_tracks ();
-			std::stringstream year;
-			year << metadata.year ();
-
-			std::map<char, std::string> subs {
-				{'a', metadata.artist ()},
-				{'b', PBD::basename_nosuffix (filename)},
-				{'c', metadata.copyright ()},
-				{'d', Glib::path_get_dirname (filename) + G_DIR_SEPARATOR},
-				{'f', filename},
-				{'l', metadata.lyricist ()},
-				{'n', session.name ()},
-				{'s', session.path ()},
-				{'o', metadata.conductor ()},
-				{'t', metadata.title ()},
-				{'z', metadata.organization ()},
-				{'A', metadata.album ()},
-				{'C', metadata.comment ()},
-				{'E', metadata.engineer ()},
-				{'G', metadata.genre ()},
-				{'L', total_tracks.str ()},
-				{'M', metadata.mixer ()},
-				{'N', current_timespan->name()}, // =?= config_map.begin()->first->name ()
-				{'O', metadata.composer ()},
-				{'P', metadata.producer ()},
-				{'S', metadata.disc_subtitle ()},
-				{'T', track_number.str ()},
-				{'Y', year.str ()},
-				{'Z', metadata.country ()}
-			};
-
-			ARDOUR::SystemExec *se = new ARDOUR::SystemExec(fmt->command(), subs, true);
-			info << "Post-export command line : {" << se->to_s () << "}" << endmsg;
-			se->ReadStdout.connect_same_thread(command_connection, std::bind(&ExportHandler::command_output, this, _1, _2));
-			int ret = se->start (SystemExec::MergeWithStdin);
-			if (ret == 0) {
-				// successfully started
-				while (se->is_running ()) {
-					// wait for system exec to terminate
-					Glib::usleep (1000);
+			if (fmt->tag()) {
+				/* TODO: check Umlauts and encoding in filename.
+				 * TagLib eventually calls CreateFileA(),
+				 */
+				export_status->active_job = ExportStatus::Tagging;
+				AudiofileTagger::tag_file(filename, *SessionMetadata::Metadata());
+			}
+
+			if (!fmt->command().empty()) {
+				SessionMetadata const & metadata (*SessionMetadata::Metadata());
+
+				export_status->active_job = ExportStatus::Command;
+				PBD::ScopedConnection command_connection;
+
+				std::stringstream track_number;
+				track_number << metadata.track_number ();
+				std::stringstream total_tracks;
+				total_tracks << metadata.total_tracks ();
+				std::stringstream year;
+				year << metadata.year ();
+
+				std::map<char, std::string> subs {
+					{'a', metadata.artist ()},
+					{'b', PBD::basename_nosuffix (filename)},
+					{'c', metadata.copyright ()},
+					{'d', Glib::path_get_dirname (filename) + G_DIR_SEPARATOR},
+					{'f', filename},
+					{'l', metadata.lyricist ()},
+					{'n', session.name ()},
+					{'s', session.path ()},
+					{'o', metadata.conductor ()},
+					{'t', metadata.title ()},
+					{'z', metadata.organization ()},
+					{'A', metadata.album ()},
+					{'C', metadata.comment ()},
+					{'E', metadata.engineer ()},
+					{'G', metadata.genre ()},
+					{'L', total_tracks.str ()},
+					{'M', metadata.mixer ()},
+					{'N', current_timespan->name()}, // =?= config_map.begin()->first->name ()
+					{'O', metadata.composer ()},
+					{'P', metadata.producer ()},
+					{'S', metadata.disc_subtitle ()},
+					{'T', track_number.str ()},
+					{'Y', year.str ()},
+					{'Z', metadata.country ()}
+				};
+
+				ARDOUR::SystemExec *se = new ARDOUR::SystemExec(fmt->command(), subs, true);
+				info << "Post-export command line : {" << se->to_s () << "}" << endmsg;
+				se->ReadStdout.connect_same_thread(command_connection, std::bind(&ExportHandler::command_output, this, _1, _2));
+				int ret = se->start (SystemExec::MergeWithStdin);
+				if (ret == 0) {
+					// successfully started
+					while (se->is_running ()) {
+						// wait for system exec to terminate
+						Glib::usleep (1000);
+					}
+				} else {
+					error << "Post-export command FAILED with Error: " << ret << endmsg;
 				}
-			} else {
-				error << "Post-export command FAILED with Error: " << ret << endmsg;
+				delete (se);
 			}
-			delete (se);
-		}
 
-		// XXX THIS IS IN REALTIME CONTEXT, CALLED FROM
-		// AudioEngine::process_callback()
-		// freewheeling, yes, but still uploading here is NOT
-		// a good idea.
-		//
-		// even less so, since SoundcloudProgress is using
-		// connect_same_thread() - GUI updates from the RT thread
-		// will cause crashes. http://pastebin.com/UJKYNGHR
-		if (fmt->soundcloud_upload()) {
-			SoundcloudUploader *soundcloud_uploader = new SoundcloudUploader;
-			std::string token = soundcloud_uploader->Get_Auth_Token(soundcloud_username, soundcloud_password);
-			DEBUG_TRACE (DEBUG::Soundcloud, string_compose(
-						"uploading %1 - username=%2, password=%3, token=%4",
-						filename, soundcloud_username, soundcloud_password, token) );
-			std::string path = soundcloud_uploader->Upload (
-					filename,
-					PBD::basename_nosuffix(filename), // title
-					token,
-					soundcloud_make_public,
-					soundcloud_downloadable,
-					this);
-
-			if (path.length() != 0) {
-				info << string_compose ( _("File %1 uploaded to %2"), filename, path) << endmsg;
-				if (soundcloud_open_page) {
-					DEBUG_TRACE (DEBUG::Soundcloud, string_compose ("opening %1", path) );
-					open_uri(path.c_str());  // open the soundcloud website to the new file
+			// XXX THIS IS IN REALTIME CONTEXT, CALLED FROM
+			// AudioEngine::process_callback()
+			// freewheeling, yes, but still uploading here is NOT
+			// a good idea.
+			//
+			// even less so, since SoundcloudProgress is using
+			// connect_same_thread() - GUI updates from the RT thread
+			// will cause crashes. http://pastebin.com/UJKYNGHR
+			if (fmt->soundcloud_upload()) {
+				SoundcloudUploader *soundcloud_uploader = new SoundcloudUploader;
+				std::string token = soundcloud_uploader->Get_Auth_Token(soundcloud_username, soundcloud_password);
+				DEBUG_TRACE (DEBUG::Soundcloud, string_compose(
+							"uploading %1 - username=%2, password=%3, token=%4",
+							filename, soundcloud_username, soundcloud_password, token) );
+				std::string path = soundcloud_uploader->Upload (
+						filename,
+						PBD::basename_nosuffix(filename), // title
+						token,
+						soundcloud_make_public,
+						soundcloud_downloadable,
+						this);
+
+				if (path.length() != 0) {
+					info << string_compose ( _("File %1 uploaded to %2"), filename, path) << endmsg;
+					if (soundcloud_open_page) {
+						DEBUG_TRACE (DEBUG::Soundcloud, string_compose ("opening %1", path) );
+						open_uri(path.c_str());  // open the soundcloud website to the new file
+					}
+				} else {
+					error << _("upload to Soundcloud failed. Perhaps your email or password are incorrect?\n") << endmsg;
 				}
-			} else {
-				error << _("upload to Soundcloud failed. Perhaps your email or password are incorrect?\n") << endmsg;
+				delete soundcloud_uploader;
 			}
-			delete soundcloud_uploader;
+			config_map.erase (timespan_bounds.first++);
 		}
-		config_map.erase (config_map.begin());
 	}
 
 	/* finish timespan is called in freewheeling rt-context,
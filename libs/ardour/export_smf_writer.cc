@@ -68,6 +68,10 @@ ExportSMFWriter::process (MidiBuffer const& buf, sampleoffset_t off, samplecnt_t
 		if (ev.time () < off) {
 			continue;
 		}
+		if (ev.time () >= off + n_samples) {
+			/* past the end of this timespan */
+			break;
+		}
 
 		samplepos_t pos = _pos + ev.time () - off;
 		assert (pos >= _last_ev_time_samples);
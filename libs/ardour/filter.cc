@@ -21,6 +21,8 @@
 #include <time.h>
 #include <cerrno>
 
+#include <glibmm/threads.h>
+
 #include "pbd/basename.h"
 
 #include "ardour/analyser.h"
@@ -39,9 +41,17 @@ using namespace std;
 using namespace ARDOUR;
 using namespace PBD;
 
+/* Filters may run concurrently (e.g. time-stretching a selection of
+ * regions). Picking a unique name and creating the source needs to be
+ * atomic, or two filters could pick the same path.
+ */
+static Glib::Threads::Mutex new_source_lock;
+
 int
 Filter::make_new_sources (std::shared_ptr<Region> region, SourceList& nsrcs, std::string suffix, bool use_session_sample_rate)
 {
+	Glib::Threads::Mutex::Lock lm (new_source_lock);
+
 	vector<string> names = region->master_source_names();
 	const SourceList::size_type nsrc = region->sources().size();
 	assert (nsrc <= names.size());
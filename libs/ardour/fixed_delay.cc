@@ -16,6 +16,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <limits>
+
 #include "ardour/audio_buffer.h"
 #include "ardour/buffer_set.h"
 #include "ardour/fixed_delay.h"
@@ -139,28 +141,20 @@ FixedDelay::delay (
 
 		mout->clear ();
 
-		/* delay events from input buffer and append them to the
-		 * corresponding buffer.
+		/* delay events from input buffer, then move the ones
+		 * that are due later to the delay-buffer.
 		 */
 		for (MidiBuffer::const_iterator m = mb->begin (); m != mb->end (); ++m) {
 			Evoral::Event<MidiBuffer::TimeType> ev (*m, false);
 			ev.set_time (ev.time () + _delay);
-			if (ev.time () < n_samples) {
-				mout->push_back (ev);
-			} else {
-				mdly->insert_event (ev);
-			}
+			mout->push_back (ev);
 		}
+		mdly->merge_in_place (*mout, n_samples, std::numeric_limits<MidiBuffer::TimeType>::max ());
+		mout->truncate (n_samples);
 
 		/* move events from the delay-buffer into output */
-		for (MidiBuffer::iterator m = mdly->begin (); m != mdly->end ();) {
-			const Evoral::Event<MidiBuffer::TimeType> ev (*m, false);
-			if (ev.time () >= n_samples) {
-				break;
-			}
-			mout->insert_event (ev);
-			m = mdly->erase (m);
-		}
+		mout->merge_in_place (*mdly, 0, n_samples);
+		mdly->silence (n_samples);
 
 		/* prepare for next cycle */
 		for (MidiBuffer::iterator m = mdly->begin (); m != mdly->end (); ++m) {
@@ -132,6 +132,7 @@
 #include "ardour/transport_master_manager.h"
 #include "ardour/triggerbox.h"
 #include "ardour/uri_map.h"
+#include "ardour/worker.h"
 
 #include "audiographer/routines.h"
 
@@ -1069,6 +1070,7 @@ ARDOUR::reset_performance_meters (Session *session)
 		for (size_t n = 0; n < Session::NTT; ++n) {
 			session->dsp_stats[n].queue_reset ();
 		}
+		session->reset_event_stats ();
 	}
 	for (size_t n = 0; n < AudioEngine::NTT; ++n) {
 		AudioEngine::instance()->dsp_stats[n].queue_reset ();
@@ -1076,6 +1078,7 @@ ARDOUR::reset_performance_meters (Session *session)
 	for (size_t n = 0; n < AudioBackend::NTT; ++n) {
 		AudioEngine::instance()->current_backend()->dsp_stats[n].queue_reset ();
 	}
+	WorkerPool::reset_stats ();
 }
 
 ARDOUR::AnyTime::AnyTime (std::string const & str)
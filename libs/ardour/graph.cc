@@ -60,6 +60,9 @@ alloc_allowed ()
 }
 #endif
 
+/* set while a graph thread processes a node */
+static thread_local bool graph_node_running = false;
+
 Graph::Graph (Session& session)
 	: SessionHandleRef (session)
 	, _execution_sem ("graph_execution", 0)
@@ -73,9 +76,13 @@ Graph::Graph (Session& session)
 	_n_workers.store (0);
 	_idle_thread_cnt.store (0);
 	_trigger_queue_size.store (0);
+	_collect_stats.store (false);
+	_stats_nodes_run.store (0);
+	_stats_busy_time.store (0);
 
 	/* pre-allocate memory */
 	_trigger_queue.reserve (1024);
+	_nested_queue.reserve (1024);
 
 	ARDOUR::AudioEngine::instance ()->Running.connect_same_thread (engine_connections, std::bind (&Graph::reset_thread_list, this));
 	ARDOUR::AudioEngine::instance ()->Stopped.connect_same_thread (engine_connections, std::bind (&Graph::engine_stopped, this));
@@ -301,13 +308,9 @@ Graph::run_one ()
 		 * other threads.
 		 * This thread as not yet decreased _trigger_queue_size.
 		 */
-		uint32_t idle_cnt   = _idle_thread_cnt.load();
 		uint32_t work_avail = _trigger_queue_size.load();
-		uint32_t wakeup     = std::min (idle_cnt + 1, work_avail);
-
-		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 signals %2 threads\n", pthread_name (), wakeup));
-		for (guint i = 1; i < wakeup; ++i) {
-			_execution_sem.signal ();
+		if (work_avail > 1) {
+			wake_idle_threads (work_avail - 1);
 		}
 	}
 
@@ -323,9 +326,11 @@ Graph::run_one ()
 			return;
 		}
 
+		/* the thread that signalled us has already removed us from _idle_thread_cnt */
 		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 is awake\n", pthread_name ()));
 
-		PBD::atomic_dec_and_test (_idle_thread_cnt);
+		/* Help with tasks dispatched by a node in another thread */
+		run_nested ();
 
 		/* Try to find some work to do */
 		_trigger_queue.pop_front (to_run);
@@ -341,11 +346,68 @@ Graph::run_one ()
 
 	/* Process the graph-node */
 	PBD::atomic_dec_and_test (_trigger_queue_size);
-	to_run->run (_graph_chain);
+
+	graph_node_running = true;
+	if (_collect_stats.load (std::memory_order_relaxed)) {
+		microseconds_t t0 = PBD::get_microseconds ();
+		to_run->run (_graph_chain);
+		_stats_busy_time.fetch_add (PBD::get_microseconds () - t0, std::memory_order_relaxed);
+		_stats_nodes_run.fetch_add (1, std::memory_order_relaxed);
+	} else {
+		to_run->run (_graph_chain);
+	}
+	graph_node_running = false;
 
 	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 has finished run_one()\n", pthread_name ()));
 }
 
+/** Wake up at most \p n threads that are currently asleep in run_one().
+ *
+ * Threads are taken off _idle_thread_cnt here, before they are signalled,
+ * so that concurrent callers cannot wake the same idle thread twice and
+ * no signal is left pending on _execution_sem for a thread that is busy.
+ *
+ * @return number of threads that were woken up
+ */
+uint32_t
+Graph::wake_idle_threads (uint32_t n)
+{
+	uint32_t idle_cnt = _idle_thread_cnt.load ();
+	uint32_t wakeup;
+	do {
+		wakeup = std::min (idle_cnt, n);
+		if (wakeup == 0) {
+			return 0;
+		}
+	} while (!_idle_thread_cnt.compare_exchange_weak (idle_cnt, idle_cnt - wakeup));
+
+	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 signals %2 threads\n", pthread_name (), wakeup));
+	for (uint32_t i = 0; i < wakeup; ++i) {
+		_execution_sem.signal ();
+	}
+	return wakeup;
+}
+
+void
+Graph::set_collect_stats (bool yn)
+{
+	_collect_stats.store (yn);
+}
+
+void
+Graph::reset_stats ()
+{
+	_stats_nodes_run.store (0);
+	_stats_busy_time.store (0);
+}
+
+void
+Graph::get_stats (uint64_t& nodes_run, microseconds_t& busy_time) const
+{
+	nodes_run = _stats_nodes_run.load ();
+	busy_time = _stats_busy_time.load ();
+}
+
 void
 Graph::helper_thread ()
 {
@@ -599,6 +661,60 @@ Graph::process_tasklist (RTTaskList const& rt)
 	DEBUG_TRACE (DEBUG::ProcessThreads, "graph execution complete\n");
 }
 
+/** Process tasks in parallel, while the graph is running.
+ *
+ * This is called by a node (e.g. a Route) that is processed by a graph-thread.
+ * Idle graph threads are woken up to help, and the calling thread
+ * processes tasks itself until the queue is empty. It then sleeps until
+ * the thread that completes the last task signals the tasklist.
+ */
+void
+Graph::process_nested_tasklist (RTTaskList const& rt)
+{
+	assert (in_graph_node ());
+
+	std::vector<RTTask> const& tasks = rt.tasks ();
+	if (tasks.empty ()) {
+		return;
+	}
+
+	for (auto const& t : tasks) {
+		assert (t._pending && t._done);
+		_nested_queue.push_back (const_cast<RTTask*>(&t));
+	}
+
+	wake_idle_threads (tasks.size () - 1);
+
+	run_nested ();
+
+	/* wait for tasks that are still processed by other threads */
+	tasks.front ()._done->wait ();
+}
+
+void
+Graph::run_nested ()
+{
+	ProcessNode* task;
+	bool         fetched = false;
+	bool const   in_node = graph_node_running;
+
+	graph_node_running = true;
+	while (_nested_queue.pop_front (task)) {
+		if (!fetched) {
+			Temporal::TempoMap::fetch ();
+			fetched = true;
+		}
+		task->run (_graph_chain);
+	}
+	graph_node_running = in_node;
+}
+
+bool
+Graph::in_graph_node ()
+{
+	return graph_node_running;
+}
+
 /* ****************************************************************************/
 
 GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
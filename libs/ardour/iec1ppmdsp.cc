@@ -69,6 +69,46 @@ Iec1ppmdsp::process (float const* p, int n)
 	_m = m;
 }
 
+/* Process four meters at once, using one SIMD lane per channel.
+ * `if (t > z) z += w * (t - z)` is expressed as a branch-free max.
+ */
+void
+Iec1ppmdsp::process4 (Iec1ppmdsp* mtr, float const* const* p, int n)
+{
+	float z1[4], z2[4], m[4];
+
+	for (int c = 0; c < 4; ++c) {
+		z1[c] = mtr[c]._z1 > 20 ? 20 : (mtr[c]._z1 < 0 ? 0 : mtr[c]._z1);
+		z2[c] = mtr[c]._z2 > 20 ? 20 : (mtr[c]._z2 < 0 ? 0 : mtr[c]._z2);
+		m[c]  = mtr[c]._res ? 0 : mtr[c]._m;
+		mtr[c]._res = false;
+	}
+
+	n /= 4;
+	for (int i = 0; i < n; ++i) {
+		for (int c = 0; c < 4; ++c) {
+			z1[c] *= _w3;
+			z2[c] *= _w3;
+		}
+		for (int k = 4 * i; k < 4 * i + 4; ++k) {
+			for (int c = 0; c < 4; ++c) {
+				const float t = fabsf (p[c][k]);
+				z1[c] += _w1 * fmaxf (t - z1[c], 0.f);
+				z2[c] += _w2 * fmaxf (t - z2[c], 0.f);
+			}
+		}
+		for (int c = 0; c < 4; ++c) {
+			m[c] = fmaxf (m[c], z1[c] + z2[c]);
+		}
+	}
+
+	for (int c = 0; c < 4; ++c) {
+		mtr[c]._z1 = z1[c] + 1e-10f;
+		mtr[c]._z2 = z2[c] + 1e-10f;
+		mtr[c]._m  = m[c];
+	}
+}
+
 float
 Iec1ppmdsp::read (void)
 {
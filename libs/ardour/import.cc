@@ -24,6 +24,7 @@
 #include "libardour-config.h"
 #endif
 
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 #include <string>
@@ -44,6 +45,9 @@
 
 #include "pbd/basename.h"
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
+#include "pbd/pthread_utils.h"
+#include "pbd/semutils.h"
 
 #include "evoral/SMF.h"
 
@@ -254,9 +258,21 @@ compose_status_message (const string& path,
 	return string_compose (_("Copying %1"), Glib::path_get_basename (path));
 }
 
+/** Read (and resample) blocks from @a source, then de-interleave and write
+ * them to @a newfiles. Peak-files are computed as part of the write.
+ *
+ * Reading, which includes decoding and sample-rate conversion, is done
+ * in a helper thread, so that the next block is prepared while the
+ * current one is being written.
+ *
+ * @a progress is either the status' progress, or the progress of one of
+ * several concurrent jobs (std::atomic<float>).
+ */
+template <typename Progress>
 static void
 write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
-                               vector<std::shared_ptr<Source> >& newfiles)
+                               vector<std::shared_ptr<Source> >& newfiles,
+                               Progress& progress)
 {
 	const samplecnt_t nframes = ResampledImportableSource::blocksize;
 	std::shared_ptr<AudioFileSource> afs;
@@ -277,7 +293,7 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 	std::shared_ptr<AudioSource> s = std::dynamic_pointer_cast<AudioSource> (newfiles[0]);
 	assert (s);
 
-	status.progress = 0.0f;
+	progress = 0.0f;
 	float progress_multiplier = 1;
 	float progress_base = 0;
 	const float progress_length = source->ratio() * source->length();
@@ -301,7 +317,7 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 			peak = compute_peak (data.get(), nread, peak);
 
 			read_count += nread / channels;
-			status.progress = 0.5 * read_count / progress_length;
+			progress = 0.5 * read_count / progress_length;
 		}
 
 		if (peak >= 1) {
@@ -314,15 +330,40 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 		progress_base = 0.5;
 	}
 
+	/* double-buffered read-ahead */
+	std::unique_ptr<float[]> ahead (new float[nframes * channels]);
+	float*      block[2] = { data.get (), ahead.get () };
+	samplecnt_t block_nread[2] = { 0, 0 };
+
+	PBD::Semaphore to_fill ("import read", 2);
+	PBD::Semaphore to_write ("import write", 0);
+
+	PBD::Thread* reader = PBD::Thread::create ([&] () {
+			for (uint32_t b = 0; ; b = (b + 1) % 2) {
+				to_fill.wait ();
+				block_nread[b] = status.cancel ? 0 : source->read (block[b], nframes * channels);
+				to_write.signal ();
+				if (block_nread[b] == 0) {
+					break;
+				}
+			}
+		}, "ImportReader");
+
 	samplecnt_t read_count = 0;
 
-	while (!status.cancel) {
+	for (uint32_t b = 0; !status.cancel; b = (b + 1) % 2) {
 
 		samplecnt_t nread, nfread;
 		uint32_t x;
 		uint32_t chn;
 
-		if ((nread = source->read (data.get(), nframes * channels)) == 0) {
+		if (reader) {
+			to_write.wait ();
+		} else {
+			block_nread[b] = source->read (block[b], nframes * channels);
+		}
+
+		if ((nread = block_nread[b]) == 0) {
 #ifdef PLATFORM_WINDOWS
 			/* Flush the data once we've finished importing the file. Windows can  */
 			/* cache the data for very long periods of time (perhaps not writing   */
@@ -334,9 +375,11 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 			break;
 		}
 
+		float* buf = block[b];
+
 		if (gain != 1) {
 			/* here is the gain fix for out-of-range sample values that we computed earlier */
-			apply_gain_to_buffer (data.get(), nread, gain);
+			apply_gain_to_buffer (buf, nread, gain);
 		}
 
 		nfread = nread / channels;
@@ -347,10 +390,15 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 
 			samplecnt_t n;
 			for (x = chn, n = 0; n < nfread; x += channels, ++n) {
-				channel_data[chn][n] = (Sample) data[x];
+				channel_data[chn][n] = (Sample) buf[x];
 			}
 		}
 
+		/* hand the block back to the reader */
+		if (reader) {
+			to_fill.signal ();
+		}
+
 		/* flush to disk */
 
 		for (chn = 0; chn < channels; ++chn) {
@@ -360,7 +408,14 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 		}
 
 		read_count += nfread;
-		status.progress = progress_base + progress_multiplier * read_count / progress_length;
+		progress = progress_base + progress_multiplier * read_count / progress_length;
+	}
+
+	if (reader) {
+		/* when cancelled, wake up the reader so that it can terminate */
+		to_fill.signal ();
+		reader->join ();
+		delete reader;
 	}
 }
 
@@ -610,6 +665,130 @@ unique_track_names (const vector<string>& n)
 	return rv;
 }
 
+struct AudioImportJob {
+	AudioImportJob (string const& p, std::shared_ptr<ImportableSource> s, vector<std::shared_ptr<Source> > const& f)
+		: path (p)
+		, source (s)
+		, newfiles (f)
+		, progress (0)
+	{}
+
+	AudioImportJob (AudioImportJob const& other)
+		: path (other.path)
+		, source (other.source)
+		, newfiles (other.newfiles)
+		, progress (other.progress.load ())
+	{}
+
+	string                             path;
+	std::shared_ptr<ImportableSource>  source;
+	vector<std::shared_ptr<Source> >   newfiles;
+	std::atomic<float>                 progress;
+};
+
+/** max number of audio files that are opened for import at the same time */
+static const size_t max_audio_import_batch = 32;
+
+/** Finalize the peak-files of all sources of a batch, and close them.
+ * Every source keeps its peak-file open from prepare_for_peakfile_writes ()
+ * until then. Also close the input files, and announce that they are no
+ * longer used.
+ */
+static void
+finish_import_batch (vector<AudioImportJob>& jobs, ImportStatus& status)
+{
+	for (auto& j : jobs) {
+		for (auto const& s : j.newfiles) {
+			std::shared_ptr<AudioFileSource> afs = std::dynamic_pointer_cast<AudioFileSource> (s);
+			if (afs) {
+				afs->done_with_peakfile_writes (!status.cancel);
+			}
+		}
+		j.source.reset ();
+		status.InputFileDone (j.path); /* EMIT SIGNAL */
+	}
+}
+
+/** Write the data of all prepared audio files. Several files are
+ * converted concurrently, each in its own worker thread.
+ */
+static void
+import_audio_files (vector<AudioImportJob>& jobs, ImportStatus& status, samplecnt_t session_rate)
+{
+	if (jobs.empty ()) {
+		return;
+	}
+
+	const uint32_t n_threads = std::min<size_t> (std::max<uint32_t> (1, hardware_concurrency ()), jobs.size ());
+	const uint32_t current   = status.current;
+
+	vector<PBD::Thread*> threads;
+
+	if (n_threads > 1) {
+		std::atomic<size_t> next_job (0);
+
+		for (uint32_t i = 0; i < n_threads; ++i) {
+			PBD::Thread* t = PBD::Thread::create ([&] () {
+					Temporal::TempoMap::fetch ();
+					size_t j;
+					while ((j = next_job.fetch_add (1)) < jobs.size () && !status.cancel) {
+						write_audio_data_to_new_files (jobs[j].source.get (), status, jobs[j].newfiles, jobs[j].progress);
+						jobs[j].progress = 1.0;
+					}
+				}, string_compose ("Import-%1", i));
+			if (t) {
+				threads.push_back (t);
+			}
+		}
+
+		if (!threads.empty ()) {
+			status.doing_what = string_compose (_("Importing %1 files"), jobs.size ());
+		}
+
+		/* aggregate progress: the GUI displays (current - 1 + progress) / total */
+		for (bool done = threads.empty (); !done;) {
+			Glib::usleep (100000);
+			uint32_t n_done = 0;
+			float    partial = 0;
+			for (auto const& j : jobs) {
+				if (j.progress >= 1.0) {
+					++n_done;
+				} else {
+					partial += j.progress;
+				}
+			}
+			status.current  = current + n_done;
+			status.progress = partial;
+			done = n_done == jobs.size () || status.cancel;
+		}
+
+		for (auto& t : threads) {
+			t->join ();
+			delete t;
+		}
+
+		if (!threads.empty ()) {
+			status.current  = current + jobs.size ();
+			status.progress = 0;
+			finish_import_batch (jobs, status);
+			return;
+		}
+	}
+
+	for (auto& j : jobs) {
+		if (status.cancel) {
+			break;
+		}
+		status.doing_what = compose_status_message (j.path, j.source->samplerate(),
+		                                            session_rate, status.current, status.total);
+		write_audio_data_to_new_files (j.source.get (), status, j.newfiles, status.progress);
+		++status.current;
+		status.progress = 0;
+	}
+
+	finish_import_batch (jobs, status);
+}
+
 // This function is still unable to cleanly update an existing source, even though
 // it is possible to set the ImportStatus flag accordingly. The functionality
 // is disabled at the GUI until the Source implementations are able to provide
@@ -624,8 +803,11 @@ Session::import_files (ImportStatus& status)
 	uint32_t num_channels = 0;
 	vector<string> smf_names;
 	bool smf_keep_filename = false;
+	vector<AudioImportJob> audio_jobs;
 
 	status.sources.clear ();
+	status.path_sources.clear ();
+	status.path_sources.resize (status.paths.size ());
 
 	for (vector<string>::const_iterator p = status.paths.begin(); p != status.paths.end() && !status.cancel; ++p) {
 
@@ -640,6 +822,10 @@ Session::import_files (ImportStatus& status)
 				num_channels = source->channels();
 			} catch (const failed_constructor& err) {
 				error << string_compose(_("Import: cannot open input sound file \"%1\""), (*p)) << endmsg;
+				if (status.skip_unreadable) {
+					++status.current;
+					continue;
+				}
 				status.done = status.cancel = true;
 				return;
 			}
@@ -710,6 +896,10 @@ Session::import_files (ImportStatus& status)
 				}
 			} catch (...) {
 				error << _("Import: error opening MIDI file") << endmsg;
+				if (status.skip_unreadable) {
+					++status.current;
+					continue;
+				}
 				status.done = status.cancel = true;
 				return;
 			}
@@ -739,6 +929,8 @@ Session::import_files (ImportStatus& status)
 			break;
 		}
 
+		status.path_sources[p - status.paths.begin ()] = newfiles;
+
 		for (Sources::iterator i = newfiles.begin(); i != newfiles.end(); ++i) {
 			if ((afs = std::dynamic_pointer_cast<AudioFileSource>(*i)) != 0) {
 				afs->prepare_for_peakfile_writes ();
@@ -746,9 +938,16 @@ Session::import_files (ImportStatus& status)
 		}
 
 		if (source) { // audio
-			status.doing_what = compose_status_message (*p, source->samplerate(),
-			                                            sample_rate(), status.current, status.total);
-			write_audio_data_to_new_files (source.get(), status, newfiles);
+			/* audio data is written in batches. Every prepared job keeps
+			 * its input file open, so limit the size of a batch to not
+			 * run out of file descriptors.
+			 */
+			audio_jobs.push_back (AudioImportJob (*p, source, newfiles));
+			if (audio_jobs.size () >= max_audio_import_batch) {
+				import_audio_files (audio_jobs, status, sample_rate ());
+				audio_jobs.clear ();
+			}
+			continue;
 		} else if (smf_reader) { // midi
 			status.doing_what = string_compose(_("Loading MIDI file %1"), *p);
 			write_midi_data_to_new_files (smf_reader.get(), status, newfiles, status.split_midi_channels);
@@ -767,6 +966,9 @@ Session::import_files (ImportStatus& status)
 		status.progress = 0;
 	}
 
+	/* this also closes the peak-files of a pending batch when cancelled */
+	import_audio_files (audio_jobs, status, sample_rate ());
+
 	if (!status.cancel) {
 		struct tm* now;
 		time_t xnow;
@@ -779,8 +981,8 @@ Session::import_files (ImportStatus& status)
 		for (Sources::iterator x = all_new_sources.begin(); x != all_new_sources.end(); ) {
 
 			if ((afs = std::dynamic_pointer_cast<AudioFileSource>(*x)) != 0) {
+				/* peak-files were completed by import_audio_files () */
 				afs->update_header((*x)->natural_position().samples(), *now, xnow);
-				afs->done_with_peakfile_writes ();
 
 				/* now that there is data there, requeue the file for analysis */
 
@@ -816,7 +1018,18 @@ Session::import_files (ImportStatus& status)
 		}
 
 		std::copy (all_new_sources.begin(), all_new_sources.end(), std::back_inserter(status.sources));
+
+		for (auto& ps : status.path_sources) {
+			for (Sources::iterator x = ps.begin(); x != ps.end(); ) {
+				if ((smfs = std::dynamic_pointer_cast<SMFSource>(*x)) != 0 && smfs->is_empty()) {
+					x = ps.erase(x);
+				} else {
+					++x;
+				}
+			}
+		}
 	} else {
+		status.path_sources.clear ();
 		try {
 			std::for_each (all_new_sources.begin(), all_new_sources.end(), remove_file_source);
 		} catch (...) {
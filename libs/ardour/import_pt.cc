@@ -22,6 +22,7 @@
 #include <errno.h>
 #include <unistd.h>
 #include <algorithm>
+#include <map>
 #include <glibmm.h>
 
 #include "pbd/pthread_utils.h"
@@ -74,6 +75,37 @@ struct PlaylistState {
 	XMLNode* before;
 };
 
+static std::shared_ptr<Region>
+create_whole_file_region (string const& path, SourceList const& sources, timepos_t const& pos, bool use_timestamp)
+{
+	/* take all the sources we have and package them up as a region */
+
+	string region_name = region_name_from_path (path, (sources.size() > 1), false);
+
+	/* we checked in import_sndfiles() that there were not too many */
+
+	while (RegionFactory::region_by_name (region_name)) {
+		region_name = bump_name_once (region_name, '.');
+	}
+
+	PropertyList plist;
+
+	plist.add (ARDOUR::Properties::start, timepos_t (0));
+	plist.add (ARDOUR::Properties::length, timecnt_t (sources[0]->length (), pos));
+	plist.add (ARDOUR::Properties::name, region_name);
+	plist.add (ARDOUR::Properties::layer, 0);
+	plist.add (ARDOUR::Properties::whole_file, true);
+	plist.add (ARDOUR::Properties::external, true);
+
+	std::shared_ptr<Region> r = RegionFactory::create (sources, plist);
+
+	if (use_timestamp && std::dynamic_pointer_cast<AudioRegion>(r)) {
+		std::dynamic_pointer_cast<AudioRegion>(r)->special_set_position(sources[0]->natural_position());
+	}
+
+	return r;
+}
+
 bool
 Session::import_sndfile_as_region (string path, SrcQuality quality, timepos_t& pos, SourceList& sources, ImportStatus& status, uint32_t current, uint32_t total)
 {
@@ -111,37 +143,11 @@ Session::import_sndfile_as_region (string path, SrcQuality quality, timepos_t& p
 
 	/* Put the source on a region */
 	vector<std::shared_ptr<Region> > regions;
-	string region_name;
 	bool use_timestamp;
 
 	use_timestamp = (pos == timepos_t::max (Temporal::AudioTime));
 
-	/* take all the sources we have and package them up as a region */
-
-	region_name = region_name_from_path (status.paths.front(), (sources.size() > 1), false);
-
-	/* we checked in import_sndfiles() that there were not too many */
-
-	while (RegionFactory::region_by_name (region_name)) {
-		region_name = bump_name_once (region_name, '.');
-	}
-
-	PropertyList plist;
-
-	plist.add (ARDOUR::Properties::start, timepos_t (0));
-	plist.add (ARDOUR::Properties::length, timecnt_t (sources[0]->length (), pos));
-	plist.add (ARDOUR::Properties::name, region_name);
-	plist.add (ARDOUR::Properties::layer, 0);
-	plist.add (ARDOUR::Properties::whole_file, true);
-	plist.add (ARDOUR::Properties::external, true);
-
-	std::shared_ptr<Region> r = RegionFactory::create (sources, plist);
-
-	if (use_timestamp && std::dynamic_pointer_cast<AudioRegion>(r)) {
-		std::dynamic_pointer_cast<AudioRegion>(r)->special_set_position(sources[0]->natural_position());
-	}
-
-	regions.push_back (r);
+	regions.push_back (create_whole_file_region (status.paths.front(), sources, pos, use_timestamp));
 
 	/* if we're creating a new track, name it after the cleaned-up
 	 * and "merged" region name.
@@ -186,12 +192,11 @@ void
 Session::import_pt_sources (PTFFormat& ptf, ImportStatus& status)
 {
 	string fullpath;
-	bool ok = false;
 	bool onefailed = false;
 	timepos_t pos = timepos_t::max (Temporal::AudioTime);
 
 	vector<PTFFormat::wav_t>::const_iterator w;
-	uint32_t wth = 0;
+	vector<uint16_t> wav_index;
 
 	SourceList just_one_src;
 
@@ -199,58 +204,86 @@ Session::import_pt_sources (PTFFormat& ptf, ImportStatus& status)
 	pt_imported_sources.clear();
 	status.clear();
 
-	for (w = ptf.audiofiles ().begin (); w != ptf.audiofiles ().end () && !status.cancel; ++w) {
-		struct ptflookup p;
-		wth++;
-		ok = false;
+	/* Locate all media first, so that import_files() can convert
+	 * the files concurrently.
+	 */
+	for (w = ptf.audiofiles ().begin (); w != ptf.audiofiles ().end (); ++w) {
 		/* Try audio file */
 		fullpath = Glib::build_filename (Glib::path_get_dirname (ptf.path ()), "Audio Files");
 		fullpath = Glib::build_filename (fullpath, w->filename);
-		if (Glib::file_test (fullpath, Glib::FILE_TEST_EXISTS)) {
-			just_one_src.clear();
-			ok = import_sndfile_as_region (fullpath, SrcBest, pos, just_one_src, status, wth, ptf.audiofiles ().size ());
-		} else {
+		if (!Glib::file_test (fullpath, Glib::FILE_TEST_EXISTS)) {
 			/* Try fade file */
 			fullpath = Glib::build_filename (Glib::path_get_dirname (ptf.path ()), "Fade Files");
 			fullpath = Glib::build_filename (fullpath, w->filename);
-			if (Glib::file_test (fullpath, Glib::FILE_TEST_EXISTS)) {
-				just_one_src.clear();
-				ok = import_sndfile_as_region (fullpath, SrcBest, pos, just_one_src, status, wth, ptf.audiofiles ().size ());
-			} else {
-				onefailed = true;
-
-				/* ptformat knows length of sources *in PT sample rate*
-				 * BUT if ardour user later resolves missing file,
-				 * it won't be resampled, so we can only do this
-				 * when sample rates are matching
-				 */
-				if (sample_rate () == ptf.sessionrate ()) {
-					/* Insert reference to missing source */
-					samplecnt_t sourcelen = w->length;
-					XMLNode srcxml (X_("Source"));
-					srcxml.set_property ("name", w->filename);
-					srcxml.set_property ("type", "audio");
-					srcxml.set_property ("id", PBD::ID ().to_s ());
-					std::shared_ptr<Source> source = SourceFactory::createSilent (*this, srcxml, sourcelen, sample_rate ());
-					p.index1 = w->index;
-					p.id = source->id ();
-					ptfwavpair.push_back (p);
-					pt_imported_sources.push_back (source);
-					warning << string_compose (_("PT Import : MISSING `%1`, inserting ref to missing source"), fullpath) << endmsg;
-				} else {
-					warning << string_compose (_("PT Import : MISSING `%1`, please check Audio Files"), fullpath) << endmsg;
-				}
-			}
 		}
-		if (ok) {
-			p.index1 = w->index;
-			p.id = just_one_src.back ()->id ();
+		if (Glib::file_test (fullpath, Glib::FILE_TEST_EXISTS)) {
+			status.paths.push_back (fullpath);
+			wav_index.push_back (w->index);
+			continue;
+		}
 
+		onefailed = true;
+
+		/* ptformat knows length of sources *in PT sample rate*
+		 * BUT if ardour user later resolves missing file,
+		 * it won't be resampled, so we can only do this
+		 * when sample rates are matching
+		 */
+		if (sample_rate () == ptf.sessionrate ()) {
+			/* Insert reference to missing source */
+			struct ptflookup p;
+			samplecnt_t sourcelen = w->length;
+			XMLNode srcxml (X_("Source"));
+			srcxml.set_property ("name", w->filename);
+			srcxml.set_property ("type", "audio");
+			srcxml.set_property ("id", PBD::ID ().to_s ());
+			std::shared_ptr<Source> source = SourceFactory::createSilent (*this, srcxml, sourcelen, sample_rate ());
+			p.index1 = w->index;
+			p.id = source->id ();
 			ptfwavpair.push_back (p);
-			pt_imported_sources.push_back (just_one_src.back ());
+			pt_imported_sources.push_back (source);
+			warning << string_compose (_("PT Import : MISSING `%1`, inserting ref to missing source"), fullpath) << endmsg;
 		} else {
+			warning << string_compose (_("PT Import : MISSING `%1`, please check Audio Files"), fullpath) << endmsg;
+		}
+	}
+
+	if (!status.paths.empty ()) {
+		status.current = 1;
+		status.total = status.paths.size ();
+		status.freeze = false;
+		status.quality = SrcBest;
+		status.replace_existing_source = false;
+		status.split_midi_channels = false;
+		status.import_markers = false;
+		status.skip_unreadable = true;
+		status.done = false;
+		status.cancel = false;
+
+		import_files (status);
+	}
+
+	/* Files that cannot be read are skipped, status.cancel is only set
+	 * if the user cancelled, or new files could not be created.
+	 */
+	for (size_t i = 0; i < status.path_sources.size () && !status.cancel; ++i) {
+		SourceList const& sources (status.path_sources[i]);
+		if (sources.empty ()) {
 			onefailed = true;
+			continue;
 		}
+
+		just_one_src.clear ();
+		just_one_src.push_back (sources.front ());
+
+		create_whole_file_region (status.paths[i], just_one_src, pos, true);
+		SourceFactory::setup_peakfile (sources.front (), true);
+
+		struct ptflookup p;
+		p.index1 = wav_index[i];
+		p.id = sources.front ()->id ();
+		ptfwavpair.push_back (p);
+		pt_imported_sources.push_back (sources.front ());
 	}
 
 	if (pt_imported_sources.empty ()) {
@@ -263,6 +296,7 @@ Session::import_pt_sources (PTFFormat& ptf, ImportStatus& status)
 
 	status.progress = 1.0;
 	status.sources.clear ();
+	status.path_sources.clear ();
 	status.done = true;
 	status.all_done = true;
 }
@@ -279,7 +313,11 @@ Session::import_pt_rest (PTFFormat& ptf)
 	uint32_t srate = sample_rate ();
 	timepos_t latest = timepos_t (0);
 
-	vector<struct ptflookup> ptfregpair;
+	/* PT region and wav index to ardour region and source */
+	typedef multimap<uint16_t, std::shared_ptr<Region> > PTFRegionMap;
+	typedef multimap<uint16_t, std::shared_ptr<Source> > PTFSourceMap;
+	PTFRegionMap ptfregions;
+	PTFSourceMap ptfsources;
 
 	SourceList just_one_src;
 
@@ -293,41 +331,45 @@ Session::import_pt_rest (PTFFormat& ptf)
 
 	just_one_src.clear();
 	uniquetr.clear();
-	ptfregpair.clear();
 	to_import.clear();
 	regions.clear();
 	playlists.clear();
 
+	/* index imported sources by PT wav index */
+	map<PBD::ID, std::shared_ptr<Source> > sources_by_id;
+	for (SourceList::iterator x = pt_imported_sources.begin (); x != pt_imported_sources.end (); ++x) {
+		sources_by_id[(*x)->id ()] = *x;
+	}
+	for (vector<struct ptflookup>::iterator p = ptfwavpair.begin (); p != ptfwavpair.end (); ++p) {
+		map<PBD::ID, std::shared_ptr<Source> >::const_iterator x = sources_by_id.find (p->id);
+		if (x != sources_by_id.end ()) {
+			ptfsources.insert (make_pair (p->index1, x->second));
+		}
+	}
+
 	for (vector<PTFFormat::region_t>::const_iterator a = ptf.regions ().begin ();
 			a != ptf.regions ().end (); ++a) {
-		for (vector<struct ptflookup>::iterator p = ptfwavpair.begin ();
-				p != ptfwavpair.end (); ++p) {
-			if ((p->index1 == a->wave.index) && (strcmp (a->wave.filename.c_str (), "") != 0)) {
-				for (SourceList::iterator x = pt_imported_sources.begin (); x != pt_imported_sources.end (); ++x) {
-					if ((*x)->id () == p->id) {
-						/* Matched an uncreated ptf region to ardour region */
-						struct ptflookup rp;
-						PropertyList plist;
-
-						plist.add (ARDOUR::Properties::start, timepos_t (a->sampleoffset));
-						plist.add (ARDOUR::Properties::length, a->length);
-						plist.add (ARDOUR::Properties::name, a->name);
-						plist.add (ARDOUR::Properties::layer, 0);
-						plist.add (ARDOUR::Properties::whole_file, false);
-						plist.add (ARDOUR::Properties::external, true);
-
-						just_one_src.clear ();
-						just_one_src.push_back (*x);
-
-						std::shared_ptr<Region> r = RegionFactory::create (just_one_src, plist);
-						regions.push_back (r);
-
-						rp.id = regions.back ()->id ();
-						rp.index1 = a->index;
-						ptfregpair.push_back (rp);
-					}
-				}
-			}
+		if (a->wave.filename.empty ()) {
+			continue;
+		}
+		pair<PTFSourceMap::iterator, PTFSourceMap::iterator> srcs = ptfsources.equal_range (a->wave.index);
+		for (PTFSourceMap::iterator x = srcs.first; x != srcs.second; ++x) {
+			/* Matched an uncreated ptf region to ardour region */
+			PropertyList plist;
+
+			plist.add (ARDOUR::Properties::start, timepos_t (a->sampleoffset));
+			plist.add (ARDOUR::Properties::length, a->length);
+			plist.add (ARDOUR::Properties::name, a->name);
+			plist.add (ARDOUR::Properties::layer, 0);
+			plist.add (ARDOUR::Properties::whole_file, false);
+			plist.add (ARDOUR::Properties::external, true);
+
+			just_one_src.clear ();
+			just_one_src.push_back (x->second);
+
+			std::shared_ptr<Region> r = RegionFactory::create (just_one_src, plist);
+			regions.push_back (r);
+			ptfregions.insert (make_pair (a->index, r));
 		}
 	}
 
@@ -363,31 +405,29 @@ Session::import_pt_rest (PTFFormat& ptf)
 
 	/* Add regions */
 	for (vector<PTFFormat::track_t>::const_iterator a = ptf.tracks ().begin (); a != ptf.tracks ().end (); ++a) {
-		for (vector<struct ptflookup>::iterator p = ptfregpair.begin ();
-				p != ptfregpair.end (); ++p) {
-
-			if (p->index1 == a->reg.index)  {
-
-				/* Matched a ptf active region to an ardour region */
-				std::shared_ptr<Region> r = RegionFactory::region_by_id (p->id);
-				DEBUG_TRACE (DEBUG::FileUtils, string_compose ("\twav(%1) reg(%2) tr(%3)\n", a->reg.wave.filename.c_str (), a->reg.index, a->index));
-
-				/* Use audio track we know exists */
-				existing_track = dynamic_pointer_cast<AudioTrack> (route_by_name (a->name));
-				assert (existing_track);
-
-				/* Put on existing track */
-				std::shared_ptr<Playlist> playlist = existing_track->playlist ();
-				std::shared_ptr<Region> copy (RegionFactory::create (r, true));
-				playlist->clear_changes ();
-				playlist->add_region (copy, timepos_t (a->reg.startpos));
-				//add_command (new StatefulDiffCommand (playlist));
-
-				/* Collect latest end of all regions */
-				timepos_t end_of_region = timepos_t (a->reg.startpos + a->reg.length);
-				if (latest < end_of_region) {
-					latest = end_of_region;
-				}
+		pair<PTFRegionMap::iterator, PTFRegionMap::iterator> regs = ptfregions.equal_range (a->reg.index);
+
+		for (PTFRegionMap::iterator p = regs.first; p != regs.second; ++p) {
+
+			/* Matched a ptf active region to an ardour region */
+			std::shared_ptr<Region> r = p->second;
+			DEBUG_TRACE (DEBUG::FileUtils, string_compose ("\twav(%1) reg(%2) tr(%3)\n", a->reg.wave.filename.c_str (), a->reg.index, a->index));
+
+			/* Use audio track we know exists */
+			existing_track = dynamic_pointer_cast<AudioTrack> (route_by_name (a->name));
+			assert (existing_track);
+
+			/* Put on existing track */
+			std::shared_ptr<Playlist> playlist = existing_track->playlist ();
+			std::shared_ptr<Region> copy (RegionFactory::create (r, true));
+			playlist->clear_changes ();
+			playlist->add_region (copy, timepos_t (a->reg.startpos));
+			//add_command (new StatefulDiffCommand (playlist));
+
+			/* Collect latest end of all regions */
+			timepos_t end_of_region = timepos_t (a->reg.startpos + a->reg.length);
+			if (latest < end_of_region) {
+				latest = end_of_region;
 			}
 		}
 	}
@@ -3069,6 +3069,9 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("get_play_loop", &Session::get_play_loop)
 		.addFunction ("get_xrun_count", &Session::get_xrun_count)
 		.addFunction ("reset_xrun_count", &Session::reset_xrun_count)
+		.addFunction ("get_event_pool_high_water", &Session::get_event_pool_high_water)
+		.addFunction ("get_event_pool_stall_count", &Session::get_event_pool_stall_count)
+		.addFunction ("get_dropped_event_count", &Session::get_dropped_event_count)
 		.addFunction ("last_transport_start", &Session::last_transport_start)
 		.addFunction ("goto_start", &Session::goto_start)
 		.addFunction ("goto_end", &Session::goto_end)
@@ -59,21 +59,6 @@ PeakMeter::PeakMeter (Session& s, const std::string& name)
 
 PeakMeter::~PeakMeter ()
 {
-	while (_kmeter.size () > 0) {
-		delete _kmeter.back ();
-		delete _iec1meter.back ();
-		delete _iec2meter.back ();
-		delete _vumeter.back ();
-		_kmeter.pop_back ();
-		_iec1meter.pop_back ();
-		_iec2meter.pop_back ();
-		_vumeter.pop_back ();
-	}
-	while (_peak_power.size () > 0) {
-		_peak_buffer.pop_back ();
-		_peak_power.pop_back ();
-		_max_peak_signal.pop_back ();
-	}
 }
 
 std::string
@@ -82,6 +67,30 @@ PeakMeter::display_name () const
 	return _("Meter");
 }
 
+/** Run the DSP meters of the first @a n_audio audio buffers,
+ * four channels at a time, and any remaining channels one by one.
+ */
+template <typename DSP>
+static void
+process_dsp_meters (std::vector<DSP>& meters, BufferSet& bufs, uint32_t n_audio, pframes_t nframes)
+{
+	assert (meters.size () >= n_audio);
+
+	uint32_t i = 0;
+	for (; i + 4 <= n_audio; i += 4) {
+		float const* p[4] = {
+			bufs.get_audio (i).data (),
+			bufs.get_audio (i + 1).data (),
+			bufs.get_audio (i + 2).data (),
+			bufs.get_audio (i + 3).data ()
+		};
+		DSP::process4 (&meters[i], p, nframes);
+	}
+	for (; i < n_audio; ++i) {
+		meters[i].process (bufs.get_audio (i).data (), nframes);
+	}
+}
+
 /** Get peaks from @a bufs
  * Input acceptance is lenient - the first n buffers from @a bufs will
  * be metered, where n was set by the last call to setup(), excess meters will
@@ -174,19 +183,19 @@ PeakMeter::run (BufferSet& bufs, samplepos_t /*start_sample*/, samplepos_t /*end
 				_peak_buffer[n] = 0;
 			}
 		}
+	}
 
-		if (_meter_type & (MeterKrms | MeterK20 | MeterK14 | MeterK12)) {
-			_kmeter[i]->process (bufs.get_audio (i).data (), nframes);
-		}
-		if (_meter_type & (MeterIEC1DIN | MeterIEC1NOR)) {
-			_iec1meter[i]->process (bufs.get_audio (i).data (), nframes);
-		}
-		if (_meter_type & (MeterIEC2BBC | MeterIEC2EBU)) {
-			_iec2meter[i]->process (bufs.get_audio (i).data (), nframes);
-		}
-		if (_meter_type & MeterVU) {
-			_vumeter[i]->process (bufs.get_audio (i).data (), nframes);
-		}
+	if (_meter_type & (MeterKrms | MeterK20 | MeterK14 | MeterK12)) {
+		process_dsp_meters (_kmeter, bufs, n_audio, nframes);
+	}
+	if (_meter_type & (MeterIEC1DIN | MeterIEC1NOR)) {
+		process_dsp_meters (_iec1meter, bufs, n_audio, nframes);
+	}
+	if (_meter_type & (MeterIEC2BBC | MeterIEC2EBU)) {
+		process_dsp_meters (_iec2meter, bufs, n_audio, nframes);
+	}
+	if (_meter_type & MeterVU) {
+		process_dsp_meters (_vumeter, bufs, n_audio, nframes);
 	}
 
 	/* Zero any excess peaks */
@@ -218,10 +227,10 @@ PeakMeter::reset ()
 
 	/* these are handled async just fine. */
 	for (size_t n = 0; n < _kmeter.size (); ++n) {
-		_kmeter[n]->reset ();
-		_iec1meter[n]->reset ();
-		_iec2meter[n]->reset ();
-		_vumeter[n]->reset ();
+		_kmeter[n].reset ();
+		_iec1meter[n].reset ();
+		_iec2meter[n].reset ();
+		_vumeter[n].reset ();
 	}
 }
 
@@ -328,22 +337,10 @@ PeakMeter::set_max_channels (const ChanCount& chn)
 	assert (_max_peak_signal.size () == limit);
 
 	/* alloc/free other audio-only meter types. */
-	while (_kmeter.size () > n_audio) {
-		delete _kmeter.back ();
-		delete _iec1meter.back ();
-		delete _iec2meter.back ();
-		delete _vumeter.back ();
-		_kmeter.pop_back ();
-		_iec1meter.pop_back ();
-		_iec2meter.pop_back ();
-		_vumeter.pop_back ();
-	}
-	while (_kmeter.size () < n_audio) {
-		_kmeter.push_back (new Kmeterdsp ());
-		_iec1meter.push_back (new Iec1ppmdsp ());
-		_iec2meter.push_back (new Iec2ppmdsp ());
-		_vumeter.push_back (new Vumeterdsp ());
-	}
+	_kmeter.resize (n_audio);
+	_iec1meter.resize (n_audio);
+	_iec2meter.resize (n_audio);
+	_vumeter.resize (n_audio);
 	assert (_kmeter.size () == n_audio);
 	assert (_iec1meter.size () == n_audio);
 	assert (_iec2meter.size () == n_audio);
@@ -379,7 +376,7 @@ PeakMeter::meter_level (uint32_t n, MeterType type)
 			{
 				const uint32_t n_midi = current_meters.n_midi ();
 				if (CHECKSIZE (_kmeter)) {
-					return accurate_coefficient_to_dB (_kmeter[n - n_midi]->read ());
+					return accurate_coefficient_to_dB (_kmeter[n - n_midi].read ());
 				}
 			}
 			break;
@@ -388,7 +385,7 @@ PeakMeter::meter_level (uint32_t n, MeterType type)
 			{
 				const uint32_t n_midi = current_meters.n_midi ();
 				if (CHECKSIZE (_iec1meter)) {
-					return accurate_coefficient_to_dB (_iec1meter[n - n_midi]->read ());
+					return accurate_coefficient_to_dB (_iec1meter[n - n_midi].read ());
 				}
 			}
 			break;
@@ -397,7 +394,7 @@ PeakMeter::meter_level (uint32_t n, MeterType type)
 			{
 				const uint32_t n_midi = current_meters.n_midi ();
 				if (CHECKSIZE (_iec2meter)) {
-					return accurate_coefficient_to_dB (_iec2meter[n - n_midi]->read ());
+					return accurate_coefficient_to_dB (_iec2meter[n - n_midi].read ());
 				}
 			}
 			break;
@@ -405,7 +402,7 @@ PeakMeter::meter_level (uint32_t n, MeterType type)
 			{
 				const uint32_t n_midi = current_meters.n_midi ();
 				if (CHECKSIZE (_vumeter)) {
-					return accurate_coefficient_to_dB (_vumeter[n - n_midi]->read ());
+					return accurate_coefficient_to_dB (_vumeter[n - n_midi].read ());
 				}
 			}
 			break;
@@ -456,25 +453,25 @@ PeakMeter::set_meter_type (MeterType t)
 	if (t & (MeterKrms | MeterK20 | MeterK14 | MeterK12)) {
 		const size_t n_audio = current_meters.n_audio ();
 		for (size_t n = 0; n < n_audio; ++n) {
-			_kmeter[n]->reset ();
+			_kmeter[n].reset ();
 		}
 	}
 	if (t & (MeterIEC1DIN | MeterIEC1NOR)) {
 		const size_t n_audio = current_meters.n_audio ();
 		for (size_t n = 0; n < n_audio; ++n) {
-			_iec1meter[n]->reset ();
+			_iec1meter[n].reset ();
 		}
 	}
 	if (t & (MeterIEC2BBC | MeterIEC2EBU)) {
 		const size_t n_audio = current_meters.n_audio ();
 		for (size_t n = 0; n < n_audio; ++n) {
-			_iec2meter[n]->reset ();
+			_iec2meter[n].reset ();
 		}
 	}
 	if (t & MeterVU) {
 		const size_t n_audio = current_meters.n_audio ();
 		for (size_t n = 0; n < n_audio; ++n) {
-			_vumeter[n]->reset ();
+			_vumeter[n].reset ();
 		}
 	}
 
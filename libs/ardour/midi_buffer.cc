@@ -20,6 +20,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <iostream>
 
 #include "pbd/malign.h"
@@ -39,6 +40,7 @@ using namespace PBD;
 MidiBuffer::MidiBuffer(size_t capacity)
 	: Buffer (DataType::MIDI)
 	, _data (0)
+	, _scratch (0)
 	, _size (0)
 {
 	if (capacity) {
@@ -50,6 +52,7 @@ MidiBuffer::MidiBuffer(size_t capacity)
 MidiBuffer::~MidiBuffer()
 {
 	cache_aligned_free(_data);
+	cache_aligned_free(_scratch);
 }
 
 void
@@ -75,6 +78,10 @@ MidiBuffer::resize (size_t size)
 	}
 
 	cache_aligned_free (old_data);
+
+	cache_aligned_free (_scratch);
+	cache_aligned_malloc ((void**) &_scratch, size);
+
 	_capacity = size;
 
 	assert(_data);
@@ -308,13 +315,57 @@ MidiBuffer::silence (samplecnt_t nframes, samplecnt_t offset)
 		return;
 	}
 
-	for (MidiBuffer::iterator i = begin(); i != end();) {
-		const Evoral::Event<TimeType> ev(*i, false);
-		if (ev.time() >= offset && ev.time() < nframes + offset) {
-			i = erase (i);
-		} else {
-			++i;
+	/* compact remaining events in a single pass, rather than
+	 * erase()ing (and moving all later events) one at a time.
+	 */
+	const size_t header_size = sizeof (TimeType) + sizeof (Evoral::EventType);
+
+	size_t w = 0;
+	size_t r = 0;
+
+	while (r < _size) {
+		const TimeType t = *(reinterpret_cast<TimeType*>((uintptr_t)(_data + r)));
+		const int event_size = Evoral::midi_event_size (_data + r + header_size);
+
+		if (event_size < 0) {
+			/* unknown size, keep the rest as-is */
+			if (w != r) {
+				memmove (_data + w, _data + r, _size - r);
+			}
+			w += _size - r;
+			break;
 		}
+
+		const size_t len = align32 (header_size + event_size);
+
+		if (t < offset || t >= nframes + offset) {
+			if (w != r) {
+				memmove (_data + w, _data + r, len);
+			}
+			w += len;
+		}
+		r += len;
+	}
+
+	_size = w;
+
+	if (_size == 0) {
+		_silent = true;
+	}
+}
+
+void
+MidiBuffer::truncate (TimeType when)
+{
+	for (MidiBuffer::iterator i = begin(); i != end(); ++i) {
+		if ((*i).time() >= when) {
+			_size = i.offset;
+			break;
+		}
+	}
+
+	if (_size == 0) {
+		_silent = true;
 	}
 }
 
@@ -439,12 +490,16 @@ MidiBuffer::second_simultaneous_midi_byte_is_first (uint8_t a, uint8_t b)
 	return b_first;
 }
 
+struct MidiBuffer::MergeSource {
+	uint8_t const* data;
+	size_t         pos;
+	size_t         end;
+};
+
 /** Merge \a other into this buffer.  Realtime safe. */
 bool
 MidiBuffer::merge_in_place (const MidiBuffer &other)
 {
-	const size_t header_size = sizeof(TimeType) + sizeof(Evoral::EventType);
-
 	if (other.size() && size()) {
 		DEBUG_TRACE (DEBUG::MidiIO, string_compose ("merge in place, sizes %1/%2\n", size(), other.size()));
 	}
@@ -462,145 +517,155 @@ MidiBuffer::merge_in_place (const MidiBuffer &other)
 		return true;
 	}
 
-	const_iterator them = other.begin();
-	iterator us = begin();
-
-	while (them != other.end()) {
-
-		size_t bytes_to_merge;
-		ssize_t merge_offset;
+	MergeSource src[2] = {
+		{ _data, 0, _size },
+		{ other._data, 0, other._size }
+	};
 
-		/* gather up total size of events that are earlier than
-		   the event referenced by "us"
-		*/
+	return merge_sources (src, 2);
+}
 
-		merge_offset = -1;
-		bytes_to_merge = 0;
+/** Merge all events of \a other with a timestamp \a start <= time < \a end
+ * into this buffer. \a other must be sorted. Realtime safe.
+ */
+bool
+MidiBuffer::merge_in_place (const MidiBuffer &other, TimeType start, TimeType end)
+{
+	size_t first = other._size;
+	size_t last  = other._size;
 
-		while (them != other.end() && (*them).time() < (*us).time()) {
-			if (merge_offset == -1) {
-				merge_offset = them.offset;
-			}
-			bytes_to_merge += align32 (header_size + (*them).size());
-			++them;
+	for (const_iterator i = other.begin(); i != other.end(); ++i) {
+		const TimeType t = (*i).time();
+		if (t < start) {
+			continue;
+		}
+		if (first == other._size) {
+			first = i.offset;
+		}
+		if (t >= end) {
+			last = i.offset;
+			break;
 		}
+	}
 
-		/* "them" now points to either:
-		 *
-		 * 1) an event that has the same or later timestamp than the
-		 *        event pointed to by "us"
-		 *
-		 * OR
-		 *
-		 * 2) the end of the "other" buffer
-		 *
-		 * if "sz" is non-zero, there is data to be merged from "other"
-		 * into this buffer before we do anything else, corresponding
-		 * to the events from "other" that we skipped while advancing
-		 * "them".
-		 */
+	if (first >= last) {
+		return true;
+	}
 
-		if (bytes_to_merge) {
-			assert(merge_offset >= 0);
-			/* move existing */
-			memmove (_data + us.offset + bytes_to_merge, _data + us.offset, _size - us.offset);
-			/* increase _size */
-			_size += bytes_to_merge;
-			assert (_size <= _capacity);
-			/* insert new stuff */
-			memcpy  (_data + us.offset, other._data + merge_offset, bytes_to_merge);
-			/* update iterator to our own events. this is a miserable hack */
-			us.offset += bytes_to_merge;
-		}
+	if (size() + last - first > _capacity) {
+		return false;
+	}
 
-		/* if we're at the end of the other buffer, we're done */
+	MergeSource src[2] = {
+		{ _data, 0, _size },
+		{ other._data, first, last }
+	};
 
-		if (them == other.end()) {
-			break;
-		}
+	return merge_sources (src, 2);
+}
 
-		/* if we have two messages messages with the same timestamp. we
-		 * must order them correctly.
-		 */
+/** Merge events from several buffers into this buffer in a single pass.
+ * Realtime safe.
+ */
+bool
+MidiBuffer::merge_in_place (MidiBuffer const* const* others, size_t n_others)
+{
+	static const size_t max_sources = 32;
 
-		if ((*us).time() == (*them).time()) {
+	size_t total = _size;
+	for (size_t i = 0; i < n_others; ++i) {
+		assert (others[i] != this);
+		total += others[i]->size ();
+	}
 
-			DEBUG_TRACE (DEBUG::MidiIO,
-				     string_compose ("simultaneous MIDI events discovered during merge, times %1/%2 status %3/%4\n",
-						     (*us).time(), (*them).time(),
-						     (int) *(_data + us.offset + header_size),
-						     (int) *(other._data + them.offset + header_size)));
+	if (total > _capacity) {
+		return false;
+	}
 
-			uint8_t our_midi_status_byte = *(_data + us.offset + header_size);
-			uint8_t their_midi_status_byte = *(other._data + them.offset + header_size);
-			bool them_first = second_simultaneous_midi_byte_is_first (our_midi_status_byte, their_midi_status_byte);
+	while (n_others > 0) {
+		MergeSource src[max_sources];
+		size_t      n = 0;
 
-			DEBUG_TRACE (DEBUG::MidiIO, string_compose ("other message came first ? %1\n", them_first));
+		src[n++] = { _data, 0, _size };
 
-			if (!them_first) {
-				/* skip past our own event */
-				++us;
+		while (n_others > 0 && n < max_sources) {
+			if ((*others)->size () > 0) {
+				src[n++] = { (*others)->_data, 0, (*others)->_size };
 			}
+			++others;
+			--n_others;
+		}
 
-			bytes_to_merge = align32 (header_size + (*them).size());
-
-			/* move our remaining events later in the buffer by
-			 * enough to fit the one message we're going to merge
-			 */
-
-			memmove (_data + us.offset + bytes_to_merge, _data + us.offset, _size - us.offset);
-			/* increase _size */
-			_size += bytes_to_merge;
-			assert(_size <= _capacity);
-			/* insert new stuff */
-			memcpy  (_data + us.offset, other._data + them.offset, bytes_to_merge);
-			/* update iterator to our own events. this is a miserable hack */
-			us.offset += bytes_to_merge;
-			/* 'us' is now an iterator to the event right after the
-			   new ones that we merged
-			*/
-			if (them_first) {
-				/* need to skip the event pointed to by 'us'
-				   since its at the same time as 'them'
-				   (still), and we'll enter
-				*/
-
-				if (us != end()) {
-					++us;
-				}
-			}
+		if (n > 1 && !merge_sources (src, n)) {
+			return false;
+		}
+	}
 
-			/* we merged one event from the other buffer, so
-			 * advance the iterator there.
-			 */
+	return true;
+}
 
-			++them;
+/** Merge sorted events from all sources into _scratch and swap it with
+ * _data. The first source is usually this buffer itself.
+ *
+ * For events with identical timestamps, events from an earlier source
+ * are kept first, unless second_simultaneous_midi_byte_is_first()
+ * demands otherwise.
+ */
+bool
+MidiBuffer::merge_sources (MergeSource* src, size_t n_sources)
+{
+	const size_t header_size = sizeof (TimeType) + sizeof (Evoral::EventType);
 
-		} else {
+	size_t out = 0;
 
-			/* advance past our own events to get to the correct insertion
-			   point for the next event(s) from "other"
-			*/
+	for (;;) {
+		ssize_t   best = -1;
+		TimeType  best_time = 0;
+		uint8_t   best_status = 0;
 
-			while (us != end() && (*us).time() <= (*them).time()) {
-				++us;
+		for (size_t i = 0; i < n_sources; ++i) {
+			if (src[i].pos >= src[i].end) {
+				continue;
+			}
+			uint8_t const* rec    = src[i].data + src[i].pos;
+			TimeType const t      = *(reinterpret_cast<TimeType const*>((uintptr_t)rec));
+			uint8_t const  status = rec[header_size];
+
+			if (best < 0 || t < best_time || (t == best_time && second_simultaneous_midi_byte_is_first (best_status, status))) {
+				best        = i;
+				best_time   = t;
+				best_status = status;
 			}
 		}
 
-		/* check to see if we reached the end of this buffer while
-		 * looking for the insertion point.
-		 */
+		if (best < 0) {
+			break;
+		}
 
-		if (us == end()) {
+		MergeSource&   s   = src[best];
+		uint8_t const* rec = s.data + s.pos;
+		int const event_size = Evoral::midi_event_size (rec + header_size);
+		size_t len;
 
-			/* just append the rest of other and we're done*/
+		if (event_size < 0) {
+			/* unknown size, copy the remainder of this source */
+			len = s.end - s.pos;
+		} else {
+			len = std::min (align32 (header_size + event_size), s.end - s.pos);
+		}
 
-			memcpy (_data + us.offset, other._data + them.offset, other._size - them.offset);
-			_size += other._size - them.offset;
-			assert(_size <= _capacity);
-			break;
+		if (out + len > _capacity) {
+			return false;
 		}
+
+		memcpy (_scratch + out, rec, len);
+		out   += len;
+		s.pos += len;
 	}
 
+	std::swap (_data, _scratch);
+	_size   = out;
+	_silent = (_size == 0);
+
 	return true;
 }
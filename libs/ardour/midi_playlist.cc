@@ -257,9 +257,14 @@ MidiPlaylist::contained_automation()
 
 	for (RegionList::const_iterator r = regions.begin(); r != regions.end(); ++r) {
 		std::shared_ptr<MidiRegion> mr = std::dynamic_pointer_cast<MidiRegion>(*r);
+		/* do not force loading the model */
+		std::shared_ptr<MidiModel> model = mr->midi_source()->loaded_model();
+		if (!model) {
+			continue;
+		}
 
-		for (Automatable::Controls::iterator c = mr->model()->controls().begin();
-				c != mr->model()->controls().end(); ++c) {
+		for (Automatable::Controls::iterator c = model->controls().begin();
+				c != model->controls().end(); ++c) {
 			if (c->second->list()->size() > 0) {
 				ret.insert(c->first);
 			}
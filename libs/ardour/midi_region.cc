@@ -118,6 +118,9 @@ MidiRegion::do_export (string const& path) const
 	assert (!Glib::file_test (path, Glib::FILE_TEST_EXISTS));
 	newsrc = std::dynamic_pointer_cast<MidiSource> (SourceFactory::createWritable (DataType::MIDI, _session, path, _session.sample_rate (), false, true));
 
+	/* make sure the model is loaded before taking the lock */
+	midi_source(0)->model ();
+
 	{
 		/* Lock our source since we'll be reading from it.  write_to() will
 		 * take a lock on newsrc.
@@ -162,9 +165,10 @@ MidiRegion::clone (std::shared_ptr<MidiSource> newsrc, ThawList* tl) const
 		node.set_property (X_("take-id"), newsrc->take_id());
 
 		/* Lock our source since we'll be reading from it.  write_to() will
-		   take a lock on newsrc.
+		   take a lock on newsrc. The model must be loaded before that.
 		*/
 
+		ms->model ();
 		Source::ReaderLock lm (ms->mutex());
 		if (ms->write_to (lm, newsrc, Temporal::Beats(), std::numeric_limits<Temporal::Beats>::max())) {
 			delete &node;
@@ -442,7 +446,11 @@ MidiRegion::midi_source (uint32_t n) const
 void
 MidiRegion::model_changed ()
 {
-	if (!model()) {
+	/* do not force loading a deferred model, ModelChanged
+	 * is emitted once it has been loaded.
+	 */
+	std::shared_ptr<MidiModel> m = midi_source()->loaded_model ();
+	if (!m) {
 		return;
 	}
 
@@ -450,7 +458,7 @@ MidiRegion::model_changed ()
 
 	_filtered_parameters.clear ();
 
-	Automatable::Controls const & c = model()->controls();
+	Automatable::Controls const & c = m->controls();
 
 	for (Automatable::Controls::const_iterator i = c.begin(); i != c.end(); ++i) {
 		std::shared_ptr<AutomationControl> ac = std::dynamic_pointer_cast<AutomationControl> (i->second);
@@ -465,8 +473,8 @@ MidiRegion::model_changed ()
 		_model_connection, std::bind (&MidiRegion::model_automation_state_changed, this, _1)
 		);
 
-	model()->ContentsShifted.connect_same_thread (_model_shift_connection, std::bind (&MidiRegion::model_shifted, this, _1));
-	model()->ContentsChanged.connect_same_thread (_model_changed_connection, std::bind (&MidiRegion::model_contents_changed, this));
+	m->ContentsShifted.connect_same_thread (_model_shift_connection, std::bind (&MidiRegion::model_shifted, this, _1));
+	m->ContentsChanged.connect_same_thread (_model_changed_connection, std::bind (&MidiRegion::model_contents_changed, this));
 }
 
 void
@@ -478,7 +486,7 @@ MidiRegion::model_contents_changed ()
 void
 MidiRegion::model_shifted (timecnt_t distance)
 {
-	if (!model()) {
+	if (!midi_source()->loaded_model ()) {
 		return;
 	}
 
@@ -67,6 +67,7 @@ using namespace PBD;
 
 MidiSource::MidiSource (Session& s, string name, Source::Flag flags)
 	: Source(s, DataType::MIDI, name, flags)
+	, _model_deferred(false)
 	, _writing(false)
 	, _capture_length(0)
 {
@@ -74,6 +75,7 @@ MidiSource::MidiSource (Session& s, string name, Source::Flag flags)
 
 MidiSource::MidiSource (Session& s, const XMLNode& node)
 	: Source(s, node)
+	, _model_deferred(false)
 	, _writing(false)
 	, _capture_length(0)
 {
@@ -465,6 +467,11 @@ MidiSource::session_saved()
 	   XXX do we need to do this every time?
 	*/
 
+	if (_model_deferred) {
+		/* the model was never loaded, the file is unchanged */
+		return;
+	}
+
 	if (_model && _model->edited()) {
 		/* The model is edited, write its contents into the current source
 		   file (overwiting previous contents). */
@@ -485,9 +492,33 @@ MidiSource::session_saved()
 	}
 }
 
+std::shared_ptr<MidiModel>
+MidiSource::model ()
+{
+	if (!_model_deferred) {
+		return _model;
+	}
+
+	{
+		WriterLock lm (_lock);
+		if (!_model_deferred) {
+			/* loaded by another thread meanwhile */
+			return _model;
+		}
+		load_model (lm);
+		/* only now that _model is complete, other threads may use it
+		 * without taking the lock */
+		_model_deferred = false;
+	}
+
+	ModelChanged (); /* EMIT SIGNAL */
+	return _model;
+}
+
 void
 MidiSource::drop_model (const WriterLock& lock)
 {
+	_model_deferred = false;
 	_model.reset();
 	invalidate(lock);
 	ModelChanged (); /* EMIT SIGNAL */
@@ -496,6 +527,7 @@ MidiSource::drop_model (const WriterLock& lock)
 void
 MidiSource::set_model (const WriterLock& lock, std::shared_ptr<MidiModel> m)
 {
+	_model_deferred = false;
 	_model = m;
 	std::cerr << "Source " << name() << " switched to model " << _model << std::endl;
 	invalidate(lock);
@@ -75,9 +75,11 @@ MidiStretch::run (std::shared_ptr<Region> r, Progress*)
 	}
 
 	std::shared_ptr<MidiSource> src = region->midi_source(0);
+	/* model() may load the model, which takes the lock */
+	std::shared_ptr<MidiModel> old_model = src->model();
+
 	Source::ReaderLock lock (src->mutex());
 
-	std::shared_ptr<MidiModel> old_model = src->model();
 	std::shared_ptr<MidiSource> new_src = std::dynamic_pointer_cast<MidiSource>(nsrcs[0]);
 
 	if (!new_src) {
@@ -88,7 +90,7 @@ MidiStretch::run (std::shared_ptr<Region> r, Progress*)
 	Source::WriterLock sl (new_src->mutex ());
 
 	new_src->load_model (sl, true);
-	std::shared_ptr<MidiModel> new_model = new_src->model();
+	std::shared_ptr<MidiModel> new_model = new_src->loaded_model();
 	new_model->start_write();
 
 #ifdef DEBUG_MIDI_STRETCH
@@ -50,9 +50,11 @@
 #include "ardour/disk_writer.h"
 #include "ardour/event_type_map.h"
 #include "ardour/meter.h"
+#include "ardour/midi_model.h"
 #include "ardour/midi_playlist.h"
 #include "ardour/midi_port.h"
 #include "ardour/midi_region.h"
+#include "ardour/midi_source.h"
 #include "ardour/midi_track.h"
 #include "ardour/monitor_control.h"
 #include "ardour/parameter_types.h"
@@ -438,7 +440,15 @@ MidiTrack::non_realtime_locate (samplepos_t spos)
 	}
 
 	/* the source may be missing, but the control still referenced in the GUI */
-	if (!region->midi_source() || !region->model()) {
+	if (!region->midi_source()) {
+		return;
+	}
+
+	/* do not load a deferred model from the butler thread,
+	 * only chase controllers once it has been loaded.
+	 */
+	std::shared_ptr<MidiModel> model = region->midi_source()->loaded_model();
+	if (!model) {
 		return;
 	}
 
@@ -463,7 +473,7 @@ MidiTrack::non_realtime_locate (samplepos_t spos)
 
 		if ((tcontrol = std::dynamic_pointer_cast<MidiTrack::MidiControl>(c->second)) &&
 
-		    (rcontrol = region->control(tcontrol->parameter()))) {
+		    (rcontrol = model->control(tcontrol->parameter()))) {
 
 			if (rcontrol->list()->size() > 0) {
 				tcontrol->set_value(rcontrol->list()->eval(pos_beats), Controllable::NoGroup);
@@ -548,8 +558,10 @@ void
 MidiTrack::write_out_of_band_data (BufferSet& bufs, samplecnt_t nframes) const
 {
 	MidiBuffer& buf (bufs.get_midi (0));
-	buf.merge_from (_immediate_event_buffer, nframes);
-	buf.merge_from (_user_immediate_event_buffer, nframes);
+	MidiBuffer const* const immediate[] = { &_immediate_event_buffer, &_user_immediate_event_buffer };
+	if (!buf.merge_in_place (immediate, 2)) {
+		cerr << string_compose ("MidiTrack::write_out_of_band_data failed (buffer is full: size: %1 capacity %2)", buf.size (), buf.capacity ()) << endl;
+	}
 }
 
 int
@@ -38,12 +38,14 @@
 #include "ardour/buffer_set.h"
 #include "ardour/debug.h"
 #include "ardour/event_type_map.h"
+#include "ardour/graph.h"
 #include "ardour/ladspa_plugin.h"
 #include "ardour/luaproc.h"
 #include "ardour/lv2_plugin.h"
 #include "ardour/plugin.h"
 #include "ardour/plugin_insert.h"
 #include "ardour/port.h"
+#include "ardour/rt_tasklist.h"
 #include "ardour/session.h"
 #include "ardour/types.h"
 
@@ -64,15 +66,18 @@ PluginInsert::PluginInsert (Session& s, Temporal::TimeDomainProvider const & tdp
 	, _signal_analysis_collect_nsamples_max (0)
 	, _configured (false)
 	, _no_inplace (false)
+	, _parallel_inplace (false)
 	, _strict_io (false)
 	, _custom_cfg (false)
 	, _maps_from_state (false)
 	, _latency_changed (false)
 	, _bypass_port (UINT32_MAX)
 	, _inverted_bypass_enable (false)
+	, _silent_samples (0)
 {
 	_stat_reset.store (0);
 	_flush.store (0);
+	_instance_failed.store (0);
 
 	/* the first is the master */
 	if (plug) {
@@ -180,6 +185,10 @@ PluginInsert::set_count (uint32_t num)
 		PluginConfigChanged (); /* EMIT SIGNAL */
 	}
 
+	if (num > 1 && !_instance_tasks) {
+		_instance_tasks.reset (new RTTaskList (_session.process_graph ()));
+	}
+
 	return true;
 }
 
@@ -884,7 +893,8 @@ void
 PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t end, double speed, pframes_t nframes, samplecnt_t offset, bool with_auto)
 {
 	// TODO: atomically copy maps & _no_inplace
-	const bool no_inplace = _no_inplace;
+	const bool no_inplace       = _no_inplace;
+	const bool parallel_inplace = _parallel_inplace;
 	PinMappings in_map (_in_map); // TODO Split case below overrides, use const& in_map
 	PinMappings const& out_map (_out_map);
 	ChanMapping const& thru_map (_thru_map);
@@ -1116,6 +1126,29 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 				}
 			}
 		}
+	} else if (_instance_tasks && parallel_inplace && Config->get_parallel_plugin_instances () && Graph::in_graph_node ()) {
+		/* in-place processing, run replicated instances in parallel.
+		 * Every instance uses a distinct set of buffers (see check_parallel_inplace).
+		 */
+		_instance_args.bufs    = &bufs;
+		_instance_args.in_map  = &in_map;
+		_instance_args.start   = start;
+		_instance_args.end     = end;
+		_instance_args.speed   = speed;
+		_instance_args.nframes = nframes;
+		_instance_args.offset  = offset;
+		_instance_failed.store (0);
+
+		for (uint32_t pc = 0; pc < get_count (); ++pc) {
+			_instance_tasks->push_back ([this, pc] () { run_instance (pc); });
+		}
+		_instance_tasks->process ();
+
+		if (_instance_failed.load ()) {
+			deactivate ();
+		}
+		// now silence unconnected outputs
+		inplace_silence_unconnected (bufs, _out_map, nframes, offset);
 	} else {
 		/* in-place processing */
 		uint32_t pc = 0;
@@ -1338,6 +1371,12 @@ PluginInsert::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sa
 		}
 	}
 
+	if (_pending_active && Config->get_plugins_sleep_on_silence () && sleep_on_silence (bufs, nframes)) {
+		/* input is silent and the plugin's tail has decayed */
+		automation_run (start_sample, nframes, true); // evaluate automation only
+		return;
+	}
+
 	if (_pending_active) {
 #if defined MIXBUS && defined NDEBUG
 		if (!is_channelstrip ()) {
@@ -1376,6 +1415,61 @@ PluginInsert::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sa
 	 */
 }
 
+void
+PluginInsert::run_instance (uint32_t pc)
+{
+	InstanceRunArgs const& a (_instance_args);
+	if (_plugins[pc]->connect_and_run (*a.bufs, a.start, a.end, a.speed, a.in_map->p (pc), _out_map.p (pc), a.nframes, a.offset)) {
+		_instance_failed.store (1);
+	}
+}
+
+bool
+PluginInsert::sleep_on_silence (BufferSet& bufs, pframes_t nframes)
+{
+	/* only effects with audio I/O, which do not pass-thru any data */
+	if (_sidechain || _thru_map.n_total () > 0
+	    || natural_input_streams ().n_audio () == 0
+	    || natural_input_streams ().n_midi () > 0
+	    || natural_output_streams ().n_midi () > 0) {
+		_silent_samples = 0;
+		return false;
+	}
+
+	for (uint32_t pc = 0; pc < get_count (); ++pc) {
+		ChanMapping const& in_map (_in_map.p (pc));
+		for (uint32_t in = 0; in < natural_input_streams ().n_audio (); ++in) {
+			bool      valid;
+			pframes_t n;
+			uint32_t  idx = in_map.get (DataType::AUDIO, in, &valid);
+			if (valid && !bufs.get_audio (idx).check_silence (nframes, n)) {
+				_silent_samples = 0;
+				return false;
+			}
+		}
+	}
+
+	/* keep running the plugin until the tail has decayed and
+	 * silence has propagated through the plugin's latency.
+	 */
+	std::shared_ptr<Plugin> p = _plugins.front ();
+	const samplecnt_t tail = std::max<samplecnt_t> (0, std::min<samplecnt_t> (p->signal_tailtime (), Config->get_max_tail_samples ()));
+
+	if (_silent_samples <= tail + p->signal_latency ()) {
+		_silent_samples += nframes;
+		return false;
+	}
+
+	/* plugin outputs are silent, as are unconnected outputs */
+	for (uint32_t out = 0; out < bufs.count ().n_audio (); ++out) {
+		bufs.get_audio (out).silence (nframes);
+	}
+	for (uint32_t out = has_midi_bypass () ? 1 : 0; out < bufs.count ().n_midi (); ++out) {
+		bufs.get_midi (out).silence (nframes);
+	}
+	return true;
+}
+
 void
 PluginInsert::automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t end, double speed, pframes_t nframes)
 {
@@ -1678,6 +1772,7 @@ PluginInsert::mapping_changed ()
 {
 	PluginMapChanged (); /* EMIT SIGNAL */
 	_no_inplace = check_inplace ();
+	_parallel_inplace = check_parallel_inplace ();
 	_session.set_dirty();
 }
 
@@ -1768,6 +1863,38 @@ PluginInsert::check_inplace ()
 	return !inplace_ok; // no-inplace
 }
 
+/* check_inplace() only ensures that replicated instances can be processed
+ * in-place one after another. To run them concurrently, no buffer may be
+ * used by more than one instance, neither as input nor as output.
+ */
+bool
+PluginInsert::check_parallel_inplace () const
+{
+	if (get_count () < 2) {
+		return false;
+	}
+
+	/* buffer-index => plugin instance, per data-type */
+	std::map<uint32_t, uint32_t> owner[DataType::num_types];
+
+	for (uint32_t pc = 0; pc < get_count (); ++pc) {
+		ChanMapping const* maps[] = { &_in_map.p (pc), &_out_map.p (pc) };
+		for (auto const& m : maps) {
+			for (auto const& t : m->mappings ()) {
+				for (auto const& c : t.second) {
+					/* pin: c.first, buffer: c.second */
+					auto r = owner[t.first].insert (std::make_pair (c.second, pc));
+					if (!r.second && r.first->second != pc) {
+						DEBUG_TRACE (DEBUG::ChanMapping, string_compose ("%1: instances share buffer %2, no parallel processing\n", name(), c.second));
+						return false;
+					}
+				}
+			}
+		}
+	}
+	return true;
+}
+
 bool
 PluginInsert::sanitize_maps ()
 {
@@ -2187,6 +2314,7 @@ PluginInsert::configure_io (ChanCount in, ChanCount out)
 	}
 
 	_no_inplace = check_inplace ();
+	_parallel_inplace = check_parallel_inplace ();
 
 	/* only the "noinplace_buffers" thread buffers need to be this large,
 	 * this can be optimized. other buffers are fine with
@@ -41,6 +41,7 @@
 #include "ardour/circular_buffer.h"
 #include "ardour/debug.h"
 #include "ardour/filesystem_paths.h"
+#include "ardour/graph.h"
 #include "ardour/midi_port.h"
 #include "ardour/midiport_manager.h"
 #include "ardour/port_manager.h"
@@ -1269,35 +1270,20 @@ PortManager::cycle_start (pframes_t nframes, Session* s)
 	/* pre-calc/cache value */
 	falloff_cache.calc (nframes, s ? s->nominal_sample_rate () : 0);
 
-	/* TODO optimize
+	/* When varispeeding, ports are processed in parallel, see
+	 * ::queue_port_batches.
+	 *
+	 * TODO optimize
 	 *  - when speed == 1.0, the resampler copies data without processing
 	 *   it may (or may not) be more efficient to just run all in sequence.
 	 *
-	 *  - single sequential task for 'lightweight' tasks would make sense
-	 *    (run it in parallel with 'heavy' resampling.
-	 *    * output ports (sends_output()) only set a flag
-	 *    * midi-ports only scale event timestamps
-	 *
-	 *  - a threshold parallel vs searial processing may be appropriate.
-	 *    amount of work (how many connected ports are there, how
-	 *    many resamplers need to run) vs. available CPU cores and semaphore
-	 *    synchronization overhead.
-	 *
 	 *  - input ports: it would make sense to resample each input only once
 	 *    (rather than resample into each ardour-owned input port).
 	 *    A single external source-port may be connected to many ardour
 	 *    input-ports. Currently re-sampling is per input.
 	 */
-	std::shared_ptr<RTTaskList> tl;
-	if (s) {
-		tl = s->rt_tasklist ();
-	}
-	if (tl && fabs (Port::resample_ratio ()) != 1.0) {
-		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
-				tl->push_back (std::bind (&Port::cycle_start, p.second, nframes));
-			}
-		}
+	std::shared_ptr<RTTaskList> tl = queue_port_batches (&Port::cycle_start, nframes, s);
+	if (tl) {
 		tl->push_back (std::bind (&PortManager::run_input_meters, this, nframes, s ? s->nominal_sample_rate () : 0));
 		tl->process ();
 	} else {
@@ -1310,20 +1296,79 @@ PortManager::cycle_start (pframes_t nframes, Session* s)
 	}
 }
 
+static void
+run_port_batch (PortManager::Ports::const_iterator first, PortManager::Ports::const_iterator last, void (Port::*method) (pframes_t), pframes_t nframes)
+{
+	for (; first != last; ++first) {
+		if (!(first->second->flags () & TransportSyncPort)) {
+			(*first->second.*method) (nframes);
+		}
+	}
+}
+
+/** Queue Port::cycle_start or Port::cycle_end of all ports as tasks of the
+ * session's RTTaskList, if ports need to be resampled.
+ *
+ * Ports are split into a few batches with about the same number of
+ * audio-ports (which do the heavy lifting), one per process-thread.
+ * This keeps synchronization overhead low compared to one task per port.
+ *
+ * @return the tasklist to process, or a null pointer if ports should be
+ * processed sequentially.
+ */
+std::shared_ptr<RTTaskList>
+PortManager::queue_port_batches (void (Port::*method) (pframes_t), pframes_t nframes, Session* s)
+{
+	/* at least this many audio-ports per batch, to make
+	 * parallel processing worth the synchronization overhead.
+	 */
+	const uint32_t min_batch_size = 4;
+
+	if (!s || fabs (Port::resample_ratio ()) == 1.0) {
+		return std::shared_ptr<RTTaskList> ();
+	}
+
+	std::shared_ptr<RTTaskList> tl = s->rt_tasklist ();
+	if (!tl || !s->process_graph ()) {
+		return std::shared_ptr<RTTaskList> ();
+	}
+
+	uint32_t n_audio = 0;
+	for (auto const& p : *_cycle_ports) {
+		if (p.second->type () == DataType::AUDIO) {
+			++n_audio;
+		}
+	}
+
+	uint32_t const n_batches = std::min (s->process_graph ()->n_threads (), n_audio / min_batch_size);
+	if (n_batches < 2) {
+		return std::shared_ptr<RTTaskList> ();
+	}
+
+	uint32_t const batch_size = (n_audio + n_batches - 1) / n_batches;
+	uint32_t       n          = 0;
+
+	Ports::const_iterator first = _cycle_ports->begin ();
+	for (Ports::const_iterator i = _cycle_ports->begin (); i != _cycle_ports->end (); ++i) {
+		if (i->second->type () == DataType::AUDIO && ++n == batch_size) {
+			Ports::const_iterator last = std::next (i);
+			tl->push_back (std::bind (&run_port_batch, first, last, method, nframes));
+			first = last;
+			n     = 0;
+		}
+	}
+	if (first != _cycle_ports->end ()) {
+		tl->push_back (std::bind (&run_port_batch, first, _cycle_ports->end (), method, nframes));
+	}
+	return tl;
+}
+
 void
 PortManager::cycle_end (pframes_t nframes, Session* s)
 {
 	// see optimzation note in ::cycle_start()
-	std::shared_ptr<RTTaskList> tl;
-	if (s) {
-		tl = s->rt_tasklist ();
-	}
-	if (tl && fabs (Port::resample_ratio ()) != 1.0) {
-		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
-				tl->push_back (std::bind (&Port::cycle_end, p.second, nframes));
-			}
-		}
+	std::shared_ptr<RTTaskList> tl = queue_port_batches (&Port::cycle_end, nframes, s);
+	if (tl) {
 		tl->process ();
 	} else {
 		for (auto const& p : *_cycle_ports) {
@@ -1432,16 +1477,8 @@ void
 PortManager::cycle_end_fade_out (gain_t base_gain, gain_t gain_step, pframes_t nframes, Session* s)
 {
 	// see optimzation note in ::cycle_start()
-	std::shared_ptr<RTTaskList> tl;
-	if (s) {
-		tl = s->rt_tasklist ();
-	}
-	if (tl && fabs (Port::resample_ratio ()) != 1.0) {
-		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
-				tl->push_back (std::bind (&Port::cycle_end, p.second, nframes));
-			}
-		}
+	std::shared_ptr<RTTaskList> tl = queue_port_batches (&Port::cycle_end, nframes, s);
+	if (tl) {
 		tl->process ();
 	} else {
 		for (auto const& p : *_cycle_ports) {
@@ -20,10 +20,14 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <cmath>
+
 #include "pbd/error.h"
 #include "ardour/resampled_source.h"
 #include "pbd/failed_constructor.h"
 
+#include "zita-resampler/resampler.h"
+
 #include "pbd/i18n.h"
 
 using namespace ARDOUR;
@@ -38,6 +42,11 @@ const uint32_t ResampledImportableSource::blocksize = 16384U;
 ResampledImportableSource::ResampledImportableSource (std::shared_ptr<ImportableSource> src, samplecnt_t rate, SrcQuality srcq)
 	: source (src)
 	, _src_state (0)
+	, _zita_in (0)
+	, _zita_out (0)
+	, _zita_flushed (false)
+	, _zita_in_total (0)
+	, _zita_out_total (0)
 {
 	_src_type = SRC_SINC_BEST_QUALITY;
 
@@ -57,6 +66,12 @@ ResampledImportableSource::ResampledImportableSource (std::shared_ptr<Importable
 	case SrcFastest:
 		_src_type = SRC_LINEAR;
 		break;
+	case SrcZitaBest:
+		init_zita (rate, 96);
+		break;
+	case SrcZitaGood:
+		init_zita (rate, 48);
+		break;
 	}
 
 	_input = new float[blocksize];
@@ -70,11 +85,120 @@ ResampledImportableSource::~ResampledImportableSource ()
 {
 	_src_state = src_delete (_src_state) ;
 	delete [] _input;
+	for (auto& r : _zita) {
+		delete r;
+	}
+	delete [] _zita_in;
+	delete [] _zita_out;
+}
+
+bool
+ResampledImportableSource::init_zita (samplecnt_t rate, unsigned int hlen)
+{
+	/* one resampler per channel, the single channel case is vectorized */
+	for (uint32_t c = 0; c < source->channels (); ++c) {
+		_zita.push_back (new ArdourZita::Resampler ());
+		if (_zita.back ()->setup (source->samplerate (), rate, 1, hlen)) {
+			/* ratio is not supported, use libsamplerate */
+			for (auto& r : _zita) {
+				delete r;
+			}
+			_zita.clear ();
+			return false;
+		}
+	}
+	_zita_in  = new float[blocksize];
+	_zita_out = new float[blocksize];
+	return true;
+}
+
+bool
+ResampledImportableSource::refill_zita ()
+{
+	uint32_t const    nchn = source->channels ();
+	samplecnt_t const bs   = blocksize / nchn;
+
+	if (_end_of_input) {
+		if (_zita_flushed) {
+			return false;
+		}
+		/* flush, the resampler delays the signal by half the filter length */
+		for (auto& r : _zita) {
+			r->inp_data  = 0;
+			r->inp_count = r->inpsize () / 2;
+		}
+		_zita_flushed = true;
+		return true;
+	}
+
+	samplecnt_t n = source->read (_input, bs * nchn) / nchn;
+
+	/* The last read will not be a full buffer */
+	if (n < bs) {
+		_end_of_input = true;
+	}
+
+	for (uint32_t c = 0; c < nchn; ++c) {
+		float* buf = &_zita_in[c * bs];
+		for (samplecnt_t i = 0; i < n; ++i) {
+			buf[i] = _input[i * nchn + c];
+		}
+		_zita[c]->inp_data  = buf;
+		_zita[c]->inp_count = n;
+	}
+
+	_zita_in_total += n;
+	return true;
+}
+
+samplecnt_t
+ResampledImportableSource::read_zita (Sample* output, samplecnt_t nframes)
+{
+	uint32_t const nchn    = source->channels ();
+	samplecnt_t    n_out   = std::min<samplecnt_t> (nframes, blocksize) / nchn;
+	samplecnt_t    n       = 0;
+
+	while (n == 0) {
+		if (_zita[0]->inp_count == 0 && !refill_zita ()) {
+			break;
+		}
+
+		if (_end_of_input) {
+			/* limit output to the length corresponding to the input */
+			samplecnt_t limit = ceil (_zita_in_total * _src_data.src_ratio);
+			n_out = std::min (n_out, limit - _zita_out_total);
+			if (n_out <= 0) {
+				break;
+			}
+		}
+
+		for (uint32_t c = 0; c < nchn; ++c) {
+			_zita[c]->out_data  = &_zita_out[c * n_out];
+			_zita[c]->out_count = n_out;
+			_zita[c]->process ();
+		}
+
+		n = n_out - _zita[0]->out_count;
+	}
+
+	for (uint32_t c = 0; c < nchn; ++c) {
+		float const* buf = &_zita_out[c * n_out];
+		for (samplecnt_t i = 0; i < n; ++i) {
+			output[i * nchn + c] = buf[i];
+		}
+	}
+
+	_zita_out_total += n;
+	return n * nchn;
 }
 
 samplecnt_t
 ResampledImportableSource::read (Sample* output, samplecnt_t nframes)
 {
+	if (!_zita.empty ()) {
+		return read_zita (output, nframes);
+	}
+
 	int err;
 	size_t bs = floor ((float)(blocksize / source->channels())) *  source->channels();
 
@@ -129,6 +253,24 @@ ResampledImportableSource::seek (samplepos_t pos)
 
 	/* and reset things so that we start from scratch with the conversion */
 
+	_end_of_input = false;
+
+	if (!_zita.empty ()) {
+		for (auto& r : _zita) {
+			r->reset ();
+			/* pre-fill with zeros, to align input and output */
+			r->inp_count = r->inpsize () / 2 - 1;
+			r->inp_data  = 0;
+			r->out_count = 1;
+			r->out_data  = 0;
+			r->process ();
+		}
+		_zita_flushed   = false;
+		_zita_in_total  = 0;
+		_zita_out_total = 0;
+		return;
+	}
+
 	if (_src_state) {
 		src_delete (_src_state);
 	}
@@ -143,7 +285,6 @@ ResampledImportableSource::seek (samplepos_t pos)
 	_src_data.input_frames = 0;
 	_src_data.data_in = _input;
 	_src_data.end_of_input = 0;
-	_end_of_input = false;
 }
 
 samplepos_t
@@ -16,6 +16,9 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include "pbd/atomic.h"
+#include "pbd/semutils.h"
+
 #include "ardour/graph.h"
 #include "ardour/rt_task.h"
 
@@ -24,6 +27,8 @@ using namespace ARDOUR;
 RTTask::RTTask (Graph* g, std::function<void ()> const& fn)
 	: _f (fn)
 	, _graph (g)
+	, _pending (0)
+	, _done (0)
 {
 }
 
@@ -31,5 +36,11 @@ void
 RTTask::run (GraphChain const*)
 {
 	_f ();
-	_graph->reached_terminal_node ();
+	if (_pending) {
+		if (PBD::atomic_dec_and_test (*_pending)) {
+			_done->signal ();
+		}
+	} else {
+		_graph->reached_terminal_node ();
+	}
 }
@@ -23,7 +23,9 @@ using namespace ARDOUR;
 
 RTTaskList::RTTaskList (std::shared_ptr<Graph> process_graph)
 	: _graph (process_graph)
+	, _done ("rt_tasklist_done", 0)
 {
+	_n_pending.store (0);
 	_tasks.reserve (256);
 }
 
@@ -36,7 +38,14 @@ RTTaskList::push_back (std::function<void ()> fn)
 void
 RTTaskList::process ()
 {
-	if (_graph->n_threads () > 1 && _tasks.size () > 2) {
+	if (_graph->n_threads () > 1 && _tasks.size () > 1 && Graph::in_graph_node ()) {
+		_n_pending.store (_tasks.size ());
+		for (auto& t : _tasks) {
+			t._pending = &_n_pending;
+			t._done    = &_done;
+		}
+		_graph->process_nested_tasklist (*this);
+	} else if (_graph->n_threads () > 1 && _tasks.size () > 2) {
 		_graph->process_tasklist (*this);
 	} else {
 		for (auto const& fn : _tasks) {
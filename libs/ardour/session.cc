@@ -61,6 +61,7 @@
 
 #include "ardour/amp.h"
 #include "ardour/analyser.h"
+#include "ardour/analysis_feature_cache.h"
 #include "ardour/async_midi_port.h"
 #include "ardour/audio_buffer.h"
 #include "ardour/audio_port.h"
@@ -255,6 +256,8 @@ Session::Session (AudioEngine &eng,
 	, _save_queued (false)
 	, _save_queued_pending (false)
 	, _no_save_signal (false)
+	, _pending_save_thread (0)
+	, _analysis_feature_cache (0)
 	, _last_roll_location (0)
 	, _last_roll_or_reversal_location (0)
 	, _last_record_location (0)
@@ -358,6 +361,7 @@ Session::Session (AudioEngine &eng,
 	_suspend_save.store (0);
 	_playback_load.store (0);
 	_capture_load.store (0);
+	_capture_min_load.store (100);
 	_post_transport_work.store (PostTransportWork (0));
 	_processing_prohibited.store (Disabled);
 	_record_status.store (Disabled);
@@ -658,6 +662,9 @@ Session::destroy ()
 
 	Analyser::flush ();
 
+	delete _analysis_feature_cache;
+	_analysis_feature_cache = 0;
+
 	_state_of_the_state = StateOfTheState (CannotSave | Deletion);
 
 	{
@@ -4928,6 +4935,10 @@ Session::remove_source (std::weak_ptr<Source> src, bool drop_references)
 		}
 	}
 
+	if (_analysis_feature_cache) {
+		_analysis_feature_cache->remove_source (source->id ());
+	}
+
 	SourceRemoved (src); /* EMIT SIGNAL */
 	if (drop_references) {
 		source->drop_references ();
@@ -5359,7 +5370,10 @@ Session::create_audio_source_for_session (size_t n_chans, string const & base, u
 	const string path = new_audio_source_path (base, n_chans, chan, true);
 
 	if (!path.empty()) {
-		return std::dynamic_pointer_cast<AudioFileSource> (SourceFactory::createWritable (DataType::AUDIO, *this, path, sample_rate(), true, true));
+		/* The file is new and empty, so setting up the peakfile is cheap.
+		 * Do it synchronously, peaks are computed as data is written.
+		 */
+		return std::dynamic_pointer_cast<AudioFileSource> (SourceFactory::createWritable (DataType::AUDIO, *this, path, sample_rate(), true, false));
 	} else {
 		throw failed_constructor ();
 	}
@@ -130,3 +130,9 @@ Session::capture_load ()
 {
 	return (uint32_t) _capture_load.load ();
 }
+
+uint32_t
+Session::capture_min_load ()
+{
+	return (uint32_t) _capture_min_load.load ();
+}
@@ -19,6 +19,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <unistd.h>
 
@@ -38,6 +39,12 @@ using namespace ARDOUR;
 using namespace PBD;
 
 PerThreadPool* SessionEvent::pool;
+std::atomic<guint> SessionEvent::_pool_high_water (0);
+std::atomic<guint> SessionEvent::_pool_stalls (0);
+std::atomic<guint> SessionEvent::_pool_stats_generation (0);
+
+/* generation of the pool statistics last seen by this thread */
+static thread_local guint pool_stats_generation = 0;
 
 void
 SessionEvent::init_event_pool ()
@@ -54,6 +61,24 @@ SessionEvent::pool_available ()
 	return pool->per_thread_pool()->available ();
 }
 
+void
+SessionEvent::reset_pool_stats ()
+{
+	_pool_high_water = 0;
+	_pool_stalls = 0;
+
+	/* per-thread pools can only be reached from their own thread,
+	 * each thread resets its pool's high-water mark when it next
+	 * allocates an event.
+	 */
+	_pool_stats_generation.fetch_add (1);
+
+	if (pool && pool->has_per_thread_pool ()) {
+		pool->per_thread_pool ()->reset_max_usage ();
+		pool_stats_generation = _pool_stats_generation.load ();
+	}
+}
+
 bool
 SessionEvent::has_per_thread_pool ()
 {
@@ -99,6 +124,17 @@ SessionEvent::operator new (size_t)
 	                                                   p->total(), p->available(), p->used()));
 
 	ev->own_pool = p;
+
+	guint gen = _pool_stats_generation.load ();
+	if (pool_stats_generation != gen) {
+		pool_stats_generation = gen;
+		p->reset_max_usage ();
+	}
+
+	guint peak = p->max_usage ();
+	guint hwm  = _pool_high_water.load ();
+	while (peak > hwm && !_pool_high_water.compare_exchange_weak (hwm, peak)) ;
+
 	return ev;
 }
 
@@ -125,6 +161,13 @@ SessionEvent::operator delete (void *ptr, size_t /*size*/)
 	}
 }
 
+void
+SessionEventManager::reset_event_stats ()
+{
+	_pending_events_dropped = 0;
+	SessionEvent::reset_pool_stats ();
+}
+
 void
 SessionEventManager::add_event (samplepos_t sample, SessionEvent::Type type, samplepos_t target_sample)
 {
@@ -254,8 +297,8 @@ SessionEventManager::merge_event (SessionEvent* ev)
 		}
 	}
 
-	events.insert (events.begin(), ev);
-	events.sort (SessionEvent::compare);
+	/* events are kept sorted, insert before any existing event at the same time */
+	events.insert (std::lower_bound (events.begin(), events.end(), ev, SessionEvent::compare), ev);
 	next_event = events.begin();
 	set_next_event ();
 }
@@ -351,7 +351,7 @@ Session::process_export_fw (pframes_t nframes)
 
 	{
 		SessionEvent* ev;
-		while (pending_events.read (&ev, 1) == 1) {
+		while (pending_events.pop_front (ev)) {
 			merge_event (ev);
 		}
 		/* remove TransportStateChange events (which otherwise accumulate with each exported range) */
@@ -304,6 +304,7 @@ Session::get_track_statistics ()
 {
 	float pworst = 1.0f;
 	float cworst = 1.0f;
+	float cmin   = 1.0f;
 
 	std::shared_ptr<RouteList const> rl = routes.reader();
 	for (auto const& i : *rl) {
@@ -316,10 +317,12 @@ Session::get_track_statistics ()
 
 		pworst = min (pworst, tr->playback_buffer_load());
 		cworst = min (cworst, tr->capture_buffer_load());
+		cmin   = min (cmin, tr->capture_buffer_min_load());
 	}
 
 	_playback_load.store ((uint32_t) floor (pworst * 100.0f));
 	_capture_load.store ((uint32_t) floor (cworst * 100.0f));
+	_capture_min_load.store ((uint32_t) floor (cmin * 100.0f));
 
 	if (actively_recording()) {
 		set_dirty();
@@ -388,7 +391,7 @@ Session::process_with_events (pframes_t nframes)
 
 	/* handle any pending events */
 
-	while (pending_events.read (&ev, 1) == 1) {
+	while (pending_events.pop_front (ev)) {
 		merge_event (ev);
 	}
 
@@ -525,7 +528,7 @@ Session::process_with_events (pframes_t nframes)
 	if (events.empty() || next_event == events.end()) {
 		try_run_lua (nframes); // also during export ?? ->move to process_without_events()
 		/* lua scripts may inject events */
-		while (_n_lua_scripts > 0 && pending_events.read (&ev, 1) == 1) {
+		while (_n_lua_scripts > 0 && pending_events.pop_front (ev)) {
 			merge_event (ev);
 		}
 		if (events.empty() || next_event == events.end()) {
@@ -776,7 +779,7 @@ Session::process_audition (pframes_t nframes)
 
 	/* handle pending events */
 
-	while (pending_events.read (&ev, 1) == 1) {
+	while (pending_events.pop_front (ev)) {
 		merge_event (ev);
 	}
 
@@ -864,9 +867,10 @@ Session::queue_event (SessionEvent* ev)
 		return;
 	} else if (loading ()) {
 		merge_event (ev);
-	} else {
-		Glib::Threads::Mutex::Lock lm (rb_write_lock);
-		pending_events.write (&ev, 1);
+	} else if (!pending_events.push_back (ev)) {
+		_pending_events_dropped.fetch_add (1);
+		DEBUG_TRACE (DEBUG::SessionEvents, string_compose ("event queue full, dropped %1\n", enum_2_string (ev->type)));
+		delete ev;
 	}
 }
 
@@ -60,6 +60,7 @@ Session::set_controls (std::shared_ptr<AutomationControlList> cl, double val, Co
 	 * still be other signals scheduling events...
 	 */
 	if (SessionEvent::pool_available () < 8) {
+		SessionEvent::note_pool_stall ();
 		int sleeptm = std::max (40000, engine().usecs_per_cycle ());
 		int timeout = std::max (10, 1000000 / sleeptm);
 		do {
@@ -91,6 +91,7 @@
 #include "pbd/unwind.h"
 
 #include "ardour/amp.h"
+#include "ardour/analysis_feature_cache.h"
 #include "ardour/async_midi_port.h"
 #include "ardour/audio_track.h"
 #include "ardour/audioengine.h"
@@ -681,6 +682,8 @@ Session::maybe_write_autosave()
 void
 Session::remove_pending_capture_state ()
 {
+	wait_for_pending_save ();
+
 	std::string pending_state_file_path(_session_dir->root_path());
 
 	pending_state_file_path = Glib::build_filename (pending_state_file_path, legalize_for_path (_current_snapshot_name) + pending_suffix);
@@ -771,12 +774,15 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 	/* pending saves are for current snapshot only */
 	assert (!pending || ((snapshot_name.empty () || snapshot_name == _current_snapshot_name) && !template_only && !for_archive));
 
-	XMLTree tree;
+	std::unique_ptr<XMLTree> tree (new XMLTree);
 	std::string xml_path(_session_dir->root_path());
 
 	/* prevent concurrent saves from different threads */
 
 	Glib::Threads::Mutex::Lock lm (save_state_lock);
+
+	/* and wait for a previous pending save to reach the disk */
+	wait_for_pending_save ();
 	Glib::Threads::Mutex::Lock lx (save_source_lock, Glib::Threads::NOT_LOCK);
 	if (!for_archive) {
 		lx.acquire ();
@@ -833,9 +839,9 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 
 	if (template_only) {
 		mark_as_clean = false;
-		tree.set_root (&get_template());
+		tree->set_root (&get_template());
 	} else {
-		tree.set_root (&state (false, fork_state, for_archive, only_used_assets));
+		tree->set_root (&state (false, fork_state, for_archive, only_used_assets));
 	}
 
 	if (snapshot_name.empty()) {
@@ -868,9 +874,75 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 	std::string tmp_path(_session_dir->root_path());
 	tmp_path = Glib::build_filename (tmp_path, legalize_for_path (snapshot_name) + temp_suffix);
 
+	if (pending) {
+		/* The state tree is complete, and no longer references any
+		 * session objects. Serialization and disk I/O of a pending
+		 * (crash-recovery) save is done in the background, so that
+		 * periodic and record-start saves do not stall the GUI.
+		 * The next save, or removal of the pending state, waits for it.
+		 */
+		XMLTree* t = tree.release ();
+		Glib::Threads::Mutex::Lock lp (_pending_save_lock);
+		_pending_save_thread = PBD::Thread::create (std::bind (&Session::write_state_tree, this, t, tmp_path, xml_path, snapshot_name, true), "PendingSave");
+		if (!_pending_save_thread) {
+			if (write_state_tree (t, tmp_path, xml_path, snapshot_name, true)) {
+				return -1;
+			}
+		}
+	} else if (write_state_tree (tree.release (), tmp_path, xml_path, snapshot_name, false)) {
+		return -1;
+	}
+
+	if (!pending && !for_archive) {
+
+		save_history (snapshot_name);
+
+		if (mark_as_clean) {
+			unset_dirty (/* EMIT SIGNAL */ true);
+		}
+
+		if (!_no_save_signal) {
+			StateSaved (snapshot_name); /* EMIT SIGNAL */
+		}
+	}
+
+#ifndef NDEBUG
+	if (DEBUG_ENABLED (DEBUG::SaveState)) {
+		const int64_t elapsed_time_us = g_get_monotonic_time() - save_start_time;
+		DEBUG_TRACE (DEBUG::SaveState, string_compose ("saved in %1%2%3 ms\n", fixed, setprecision (1), elapsed_time_us / 1000.));
+	}
+#endif
+
+	if (!pending && !for_archive && ! template_only) {
+		remove_pending_capture_state ();
+	}
+
+	return 0;
+}
+
+void
+Session::wait_for_pending_save ()
+{
+	Glib::Threads::Mutex::Lock lm (_pending_save_lock);
+	if (_pending_save_thread) {
+		_pending_save_thread->join ();
+		delete _pending_save_thread;
+		_pending_save_thread = 0;
+	}
+}
+
+/** Write @p tree to @p tmp_path and atomically move it to @p xml_path.
+ *  Takes ownership of @p tree. This may be called from a background thread
+ *  for pending saves and must not access session state.
+ */
+int
+Session::write_state_tree (XMLTree* t, std::string const& tmp_path, std::string const& xml_path, std::string const& snapshot_name, bool pending)
+{
+	std::unique_ptr<XMLTree> tree (t);
+
 	DEBUG_TRACE (DEBUG::SaveState, string_compose ("writing state to '%1'\n", tmp_path));
 
-	if (!tree.write (tmp_path)) {
+	if (!tree->write (tmp_path)) {
 		error << string_compose (_("state could not be saved to %1"), tmp_path) << endmsg;
 		if (g_remove (tmp_path.c_str()) != 0) {
 			error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
@@ -907,7 +979,7 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 			strftime (timebuf, sizeof(timebuf), "%y-%m-%d.%H", &local_time);
 			std::string save_path(session_directory().backup_path());
 			save_path += G_DIR_SEPARATOR;
-			save_path += legalize_for_path(_current_snapshot_name);
+			save_path += legalize_for_path(snapshot_name);
 			save_path += "-";
 			save_path += timebuf;
 			save_path += statefile_suffix;
@@ -918,30 +990,6 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 		}
 	}
 
-	if (!pending && !for_archive) {
-
-		save_history (snapshot_name);
-
-		if (mark_as_clean) {
-			unset_dirty (/* EMIT SIGNAL */ true);
-		}
-
-		if (!_no_save_signal) {
-			StateSaved (snapshot_name); /* EMIT SIGNAL */
-		}
-	}
-
-#ifndef NDEBUG
-	if (DEBUG_ENABLED (DEBUG::SaveState)) {
-		const int64_t elapsed_time_us = g_get_monotonic_time() - save_start_time;
-		DEBUG_TRACE (DEBUG::SaveState, string_compose ("saved in %1%2%3 ms\n", fixed, setprecision (1), elapsed_time_us / 1000.));
-	}
-#endif
-
-	if (!pending && !for_archive && ! template_only) {
-		remove_pending_capture_state ();
-	}
-
 	return 0;
 }
 
@@ -1646,12 +1694,9 @@ Session::maybe_copy_midifile (snapshot_t snapshot_type, std::shared_ptr<Source>
 
 	/* use SMF-API to clone data (use the midi_model, not data on disk) */
 	std::shared_ptr<SMFSource> newsrc (new SMFSource (*this, path, ms->flags()));
-	{
+	if (!ms->model()) {
 		Source::WriterLock lm (ms->mutex());
-
-		if (!ms->model()) {
-			ms->load_model (lm);
-		}
+		ms->load_model (lm);
 	}
 	Source::ReaderLock lm (ms->mutex());
 	/* write_to() calls newsrc->flush_midi () to write the file to disk */
@@ -3149,6 +3194,25 @@ Session::analysis_dir () const
 	return Glib::build_filename (_path, analysis_dir_name);
 }
 
+AnalysisFeatureCache&
+Session::analysis_feature_cache ()
+{
+	if (!_analysis_feature_cache) {
+		_analysis_feature_cache = new AnalysisFeatureCache (Glib::build_filename (analysis_dir (), X_("features.cache")));
+
+		/* forget results of sources that were removed meanwhile */
+		std::set<PBD::ID> ids;
+		{
+			Glib::Threads::Mutex::Lock lm (source_lock);
+			for (auto const& i : sources) {
+				ids.insert (i.first);
+			}
+		}
+		_analysis_feature_cache->retain_sources (ids);
+	}
+	return *_analysis_feature_cache;
+}
+
 string
 Session::plugins_dir () const
 {
@@ -3765,6 +3829,9 @@ Session::cleanup_sources (CleanupReport& rep)
 	cerr << "Dead Sources: " << dead_sources.size() << endl;
 
 	for (auto const& i : dead_sources) {
+		if (_analysis_feature_cache) {
+			_analysis_feature_cache->remove_source (i->id ());
+		}
 		/* The following triggers Region::source_deleted (), which
 		 * causes regions to drop the given source */
 		i->drop_references ();
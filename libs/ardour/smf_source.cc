@@ -174,7 +174,8 @@ SMFSource::SMFSource (Session& s, const XMLNode& node, bool must_exist)
 	if (!(_flags & Source::Empty)) {
 		assert (Glib::file_test (_path, Glib::FILE_TEST_EXISTS));
 		existence_check ();
-		if (open (_path, 1, false)) {
+		/* scan for used channels etc, without loading the model */
+		if (open (_path, 1, true)) {
 			throw failed_constructor ();
 		}
 		_open = true;
@@ -186,6 +187,24 @@ SMFSource::SMFSource (Session& s, const XMLNode& node, bool must_exist)
 		/* no fd left open here */
 	}
 
+	/* Sources of a session are only needed for editing once a region
+	 * using them is shown, playback reads directly from the file.
+	 * Defer loading the model until it is first requested by model(),
+	 * unless automation of the source filters events at read time.
+	 */
+	bool defer = !(_flags & Source::Empty);
+	for (AutomationStateMap::const_iterator i = _automation_state.begin (); i != _automation_state.end (); ++i) {
+		if (i->second != Play) {
+			defer = false;
+		}
+	}
+
+	if (defer) {
+		_length = file_duration ();
+		_model_deferred = true;
+		return;
+	}
+
 	/* no lock required since we do not actually exist yet */
 	load_model_unlocked (true);
 }
@@ -26,6 +26,7 @@
 #include "libardour-config.h"
 #endif
 
+#include <algorithm>
 #include <cstring>
 #include <cerrno>
 #include <climits>
@@ -340,6 +341,10 @@ SndFileSource::init_sndfile ()
 
 	memset (&_info, 0, sizeof(_info));
 
+	_fd = -1;
+	_preallocated = 0;
+	_preallocate = false;
+
 	AudioFileSource::HeaderPositionOffsetChanged.connect_same_thread (header_position_connection, std::bind (&SndFileSource::handle_header_position_change, this));
 }
 
@@ -347,8 +352,10 @@ void
 SndFileSource::close ()
 {
 	if (_sndfile) {
+		release_preallocation ();
 		sf_close (_sndfile);
 		_sndfile = 0;
+		_fd = -1;
 		file_closed ();
 	}
 }
@@ -389,12 +396,17 @@ SndFileSource::open ()
 		return -1;
 	}
 
+	if (writable ()) {
+		_fd = fd;
+	}
+
 	if (_channel >= _info.channels) {
 #ifndef HAVE_COREAUDIO
 		error << string_compose(_("SndFileSource: file only contains %1 channels; %2 is invalid as a channel number"), _info.channels, _channel) << endmsg;
 #endif
 		sf_close (_sndfile);
 		_sndfile = 0;
+		_fd = -1;
 		return -1;
 	}
 
@@ -625,6 +637,8 @@ SndFileSource::nondestructive_write_unlocked (Sample const * data, samplecnt_t c
 	assert (_length.time_domain() == Temporal::AudioTime);
 	samplepos_t sample_pos = _length.samples();
 
+	preallocate (sample_pos + cnt);
+
 	if (write_float (data, sample_pos, cnt) != cnt) {
 		return 0;
 	}
@@ -650,7 +664,14 @@ SndFileSource::update_header (samplepos_t when, struct tm& now, time_t tnow)
 		}
 	}
 
-	return flush_header ();
+	int rv = flush_header ();
+
+	/* update_header() is called when capture ends, drop any space
+	 * that was reserved but not used.
+	 */
+	release_preallocation ();
+
+	return rv;
 }
 
 int
@@ -755,6 +776,72 @@ SndFileSource::write_float (Sample const * data, samplepos_t sample_pos, samplec
 	return cnt;
 }
 
+void
+SndFileSource::preallocate (samplepos_t end)
+{
+#if defined __linux__ && defined FALLOC_FL_KEEP_SIZE
+	if (_fd < 0 || !_preallocate || (_info.format & SF_FORMAT_TYPEMASK) == SF_FORMAT_FLAC) {
+		return;
+	}
+
+	off_t bps;
+	switch (_info.format & SF_FORMAT_SUBMASK) {
+		case SF_FORMAT_FLOAT:
+		case SF_FORMAT_PCM_32:
+			bps = 4;
+			break;
+		case SF_FORMAT_PCM_24:
+			bps = 3;
+			break;
+		case SF_FORMAT_PCM_16:
+			bps = 2;
+			break;
+		default:
+			return;
+	}
+
+	/* 64kB of slack for the header, which is not included in @param end */
+	off_t const need = end * bps * _info.channels + 65536;
+
+	if (need <= _preallocated) {
+		return;
+	}
+
+	/* reserve space in large extents, ~30 seconds at a time. Use KEEP_SIZE
+	 * so that the file's apparent length (and hence what libsndfile and
+	 * any crash-recovery sees) is unchanged.
+	 */
+	off_t const chunk = (off_t) _info.samplerate * 30 * bps * _info.channels;
+	off_t const len   = std::max (chunk, need - _preallocated);
+
+	if (fallocate (_fd, FALLOC_FL_KEEP_SIZE, _preallocated, len) == 0) {
+		_preallocated += len;
+	} else {
+		/* not supported by the file-system, or disk full; the latter
+		 * will be reported by the subsequent write.
+		 */
+		_preallocate = false;
+	}
+#endif
+}
+
+void
+SndFileSource::release_preallocation ()
+{
+#if defined __linux__ && defined FALLOC_FL_KEEP_SIZE && defined FALLOC_FL_PUNCH_HOLE
+	if (_fd < 0 || _preallocated == 0) {
+		return;
+	}
+
+	struct stat st;
+	if (fstat (_fd, &st) == 0 && st.st_size < _preallocated) {
+		/* release blocks that were reserved beyond EOF */
+		fallocate (_fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, st.st_size, _preallocated - st.st_size);
+	}
+#endif
+	_preallocated = 0;
+}
+
 void
 SndFileSource::set_natural_position (timepos_t const & pos)
 {
@@ -46,9 +46,11 @@ SrcFileSource::SrcFileSource (Session& s, std::shared_ptr<AudioFileSource> src,
 
 	switch (srcq) {
 		case SrcBest:
+		case SrcZitaBest:
 			src_type = SRC_SINC_BEST_QUALITY;
 			break;
 		case SrcGood:
+		case SrcZitaGood:
 			src_type = SRC_SINC_MEDIUM_QUALITY;
 			break;
 		case SrcQuick:
@@ -0,0 +1,112 @@
+#include "ardour/midi_buffer.h"
+#include "midi_buffer_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MidiBufferTest);
+
+using namespace ARDOUR;
+
+static void
+add_note (MidiBuffer& mb, samplepos_t t, uint8_t chn, uint8_t note)
+{
+	uint8_t buf[3] = { (uint8_t)(0x90 | chn), note, 0x7f };
+	CPPUNIT_ASSERT (mb.push_back (t, Evoral::MIDI_EVENT, 3, buf));
+}
+
+static size_t
+check_sorted (MidiBuffer const& mb)
+{
+	size_t     n    = 0;
+	samplepos_t prev = 0;
+	for (MidiBuffer::const_iterator i = mb.begin (); i != mb.end (); ++i, ++n) {
+		CPPUNIT_ASSERT ((*i).time () >= prev);
+		prev = (*i).time ();
+	}
+	return n;
+}
+
+void
+MidiBufferTest::mergeTest ()
+{
+	MidiBuffer a (8192);
+	MidiBuffer b (8192);
+
+	for (int i = 0; i < 100; ++i) {
+		add_note (a, 2 * i, 0, 60);
+		add_note (b, 2 * i + 1, 1, 62);
+	}
+
+	CPPUNIT_ASSERT (a.merge_in_place (b));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 200, check_sorted (a));
+
+	samplepos_t t = 0;
+	for (MidiBuffer::const_iterator i = a.begin (); i != a.end (); ++i, ++t) {
+		CPPUNIT_ASSERT_EQUAL (t, (*i).time ());
+	}
+}
+
+void
+MidiBufferTest::simultaneousTest ()
+{
+	MidiBuffer a (1024);
+	MidiBuffer b (1024);
+
+	add_note (a, 10, 0, 60);
+
+	uint8_t cc[3] = { 0xb0, 7, 100 };
+	b.push_back (10, Evoral::MIDI_EVENT, 3, cc);
+
+	/* controller messages precede notes on the same channel */
+	CPPUNIT_ASSERT (a.merge_in_place (b));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 2, check_sorted (a));
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 0xb0, (*a.begin ()).buffer ()[0]);
+}
+
+void
+MidiBufferTest::multiMergeTest ()
+{
+	const int n_sources = 64;
+
+	MidiBuffer  dst (65536);
+	MidiBuffer* src[n_sources];
+
+	add_note (dst, 0, 0, 1);
+
+	for (int s = 0; s < n_sources; ++s) {
+		src[s] = new MidiBuffer (1024);
+		for (int i = 0; i < 16; ++i) {
+			add_note (*src[s], i * n_sources + s, s % 16, 60);
+		}
+	}
+
+	CPPUNIT_ASSERT (dst.merge_in_place (src, n_sources));
+	CPPUNIT_ASSERT_EQUAL ((size_t) (1 + 16 * n_sources), check_sorted (dst));
+
+	for (int s = 0; s < n_sources; ++s) {
+		delete src[s];
+	}
+}
+
+void
+MidiBufferTest::rangeTest ()
+{
+	MidiBuffer a (4096);
+	MidiBuffer b (4096);
+
+	for (int i = 0; i < 10; ++i) {
+		add_note (b, 10 * i, 0, 60);
+	}
+
+	/* events 20, 30, 40 */
+	CPPUNIT_ASSERT (a.merge_in_place (b, 20, 45));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 3, check_sorted (a));
+	CPPUNIT_ASSERT_EQUAL ((samplepos_t) 20, (*a.begin ()).time ());
+
+	b.truncate (50);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 5, check_sorted (b));
+
+	b.silence (20, 10);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 3, check_sorted (b));
+
+	b.truncate (0);
+	CPPUNIT_ASSERT (b.empty ());
+}
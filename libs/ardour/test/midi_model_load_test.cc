@@ -0,0 +1,130 @@
+#include <atomic>
+#include <vector>
+
+#include <glibmm/fileutils.h>
+
+#include "pbd/compose.h"
+#include "pbd/pthread_utils.h"
+#include "pbd/xml++.h"
+
+#include "temporal/tempo.h"
+
+#include "ardour/midi_model.h"
+#include "ardour/session.h"
+#include "ardour/smf_source.h"
+
+#include "midi_model_load_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MidiModelLoadTest);
+
+using namespace std;
+using namespace ARDOUR;
+using namespace Temporal;
+
+void
+MidiModelLoadTest::setUp ()
+{
+	TestNeedingSession::setUp ();
+
+	/* write a file with two notes */
+	_source = std::dynamic_pointer_cast<SMFSource> (_session->create_midi_source_for_session ("deferred"));
+	CPPUNIT_ASSERT (_source);
+	_path = _source->path ();
+
+	uint8_t const note_on[]  = { 0x90, 60, 100 };
+	uint8_t const note_off[] = { 0x80, 60, 0 };
+
+	MidiSource::WriterLock lock (_source->mutex ());
+	_source->mark_streaming_midi_write_started (lock, Sustained);
+	for (int i = 0; i < 2; ++i) {
+		_source->append_event_beats (lock, Evoral::Event<Beats> (Evoral::MIDI_EVENT, Beats (2 * i, 0), 3, note_on));
+		_source->append_event_beats (lock, Evoral::Event<Beats> (Evoral::MIDI_EVENT, Beats (2 * i + 1, 0), 3, note_off));
+	}
+	_source->mark_streaming_write_completed (lock, timecnt_t (Beats (4, 0)));
+}
+
+void
+MidiModelLoadTest::tearDown ()
+{
+	_source.reset ();
+	TestNeedingSession::tearDown ();
+}
+
+/** Create a source for the same file, as done when loading a session */
+std::shared_ptr<SMFSource>
+MidiModelLoadTest::restore_source ()
+{
+	XMLNode& node (_source->get_state ());
+	std::shared_ptr<SMFSource> src (new SMFSource (*_session, node));
+	delete &node;
+	return src;
+}
+
+void
+MidiModelLoadTest::deferredTest ()
+{
+	std::shared_ptr<SMFSource> src = restore_source ();
+
+	/* the length is known, but the model is not loaded */
+	CPPUNIT_ASSERT (!src->loaded_model ());
+	CPPUNIT_ASSERT (src->length ().beats () >= Beats (3, 0));
+
+	std::shared_ptr<MidiModel> model = src->model ();
+	CPPUNIT_ASSERT (model);
+	CPPUNIT_ASSERT (model == src->loaded_model ());
+	CPPUNIT_ASSERT_EQUAL (size_t (2), model->n_notes ());
+
+	/* the model is loaded only once */
+	CPPUNIT_ASSERT (model == src->model ());
+}
+
+void
+MidiModelLoadTest::sessionSavedTest ()
+{
+	std::string const before = Glib::file_get_contents (_path);
+
+	std::shared_ptr<SMFSource> src = restore_source ();
+	src->session_saved ();
+
+	/* the file is not rewritten, and the model is not loaded */
+	CPPUNIT_ASSERT (!src->loaded_model ());
+	CPPUNIT_ASSERT (before == Glib::file_get_contents (_path));
+
+	CPPUNIT_ASSERT_EQUAL (size_t (2), src->model ()->n_notes ());
+}
+
+void
+MidiModelLoadTest::concurrentLoadTest ()
+{
+	std::shared_ptr<SMFSource> src = restore_source ();
+
+	std::atomic<int> n_loaded (0);
+	PBD::ScopedConnection c;
+	src->ModelChanged.connect_same_thread (c, [&n_loaded] () { ++n_loaded; });
+
+	const int                                n_threads = 8;
+	std::vector<std::shared_ptr<MidiModel> > models (n_threads);
+	std::vector<PBD::Thread*>                threads;
+
+	for (int i = 0; i < n_threads; ++i) {
+		PBD::Thread* t = PBD::Thread::create ([&models, src, i] () {
+				Temporal::TempoMap::fetch ();
+				models[i] = src->model ();
+			}, string_compose ("ModelLoad-%1", i));
+		CPPUNIT_ASSERT (t);
+		threads.push_back (t);
+	}
+
+	for (auto& t : threads) {
+		t->join ();
+		delete t;
+	}
+
+	/* every thread gets the same, complete model */
+	CPPUNIT_ASSERT_EQUAL (1, n_loaded.load ());
+	for (auto const& m : models) {
+		CPPUNIT_ASSERT (m);
+		CPPUNIT_ASSERT (m == src->loaded_model ());
+		CPPUNIT_ASSERT_EQUAL (size_t (2), m->n_notes ());
+	}
+}
@@ -0,0 +1,33 @@
+#include <memory>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "test_needing_session.h"
+
+namespace ARDOUR {
+	class SMFSource;
+}
+
+class MidiModelLoadTest : public TestNeedingSession
+{
+	CPPUNIT_TEST_SUITE (MidiModelLoadTest);
+	CPPUNIT_TEST (deferredTest);
+	CPPUNIT_TEST (sessionSavedTest);
+	CPPUNIT_TEST (concurrentLoadTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void deferredTest ();
+	void sessionSavedTest ();
+	void concurrentLoadTest ();
+
+private:
+	std::shared_ptr<ARDOUR::SMFSource> restore_source ();
+
+	std::shared_ptr<ARDOUR::SMFSource> _source;
+	std::string _path;
+};
@@ -0,0 +1,85 @@
+#include <iostream>
+#include <cstdlib>
+
+#include "pbd/microseconds.h"
+#include "pbd/pbd.h"
+
+#include "ardour/midi_buffer.h"
+
+using namespace std;
+using namespace ARDOUR;
+
+/* Worst case: many busy sources (e.g. a 64 channel controller setup)
+ * merged into a single port buffer, with interleaved timestamps.
+ */
+
+static const int n_sources = 64;
+static const int n_events  = 64; // per source and cycle
+static const int n_cycles  = 1000;
+
+static void
+fill (MidiBuffer** src)
+{
+	for (int s = 0; s < n_sources; ++s) {
+		src[s]->clear ();
+		for (int i = 0; i < n_events; ++i) {
+			uint8_t buf[3] = { (uint8_t)(0x90 | (s % 16)), (uint8_t)(i & 0x7f), 0x7f };
+			src[s]->push_back (i * n_sources + s, Evoral::MIDI_EVENT, 3, buf);
+		}
+	}
+}
+
+int
+main (int argc, char* argv[])
+{
+	PBD::init ();
+
+	const size_t capacity = n_sources * n_events * 32;
+
+	MidiBuffer  dst (capacity);
+	MidiBuffer* src[n_sources];
+
+	for (int s = 0; s < n_sources; ++s) {
+		src[s] = new MidiBuffer (n_events * 32);
+	}
+
+	fill (src);
+
+	PBD::microseconds_t insert_time = 0;
+	PBD::microseconds_t pairwise_time = 0;
+	PBD::microseconds_t kway_time = 0;
+
+	for (int c = 0; c < n_cycles; ++c) {
+		dst.clear ();
+		PBD::microseconds_t t0 = PBD::get_microseconds ();
+		for (int s = 0; s < n_sources; ++s) {
+			for (MidiBuffer::const_iterator i = src[s]->begin (); i != src[s]->end (); ++i) {
+				dst.insert_event (*i);
+			}
+		}
+		insert_time += PBD::get_microseconds () - t0;
+
+		dst.clear ();
+		t0 = PBD::get_microseconds ();
+		for (int s = 0; s < n_sources; ++s) {
+			dst.merge_in_place (*src[s]);
+		}
+		pairwise_time += PBD::get_microseconds () - t0;
+
+		dst.clear ();
+		t0 = PBD::get_microseconds ();
+		dst.merge_in_place (src, n_sources);
+		kway_time += PBD::get_microseconds () - t0;
+	}
+
+	cout << n_sources << " sources x " << n_events << " events, average per cycle:\n";
+	cout << "  insert_event   : " << insert_time / (double) n_cycles << " us\n";
+	cout << "  merge pairwise : " << pairwise_time / (double) n_cycles << " us\n";
+	cout << "  merge k-way    : " << kway_time / (double) n_cycles << " us\n";
+
+	for (int s = 0; s < n_sources; ++s) {
+		delete src[s];
+	}
+
+	return 0;
+}
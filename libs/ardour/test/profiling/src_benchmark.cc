@@ -0,0 +1,130 @@
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "pbd/microseconds.h"
+#include "pbd/pbd.h"
+
+#include "audiographer/general/sr_converter.h"
+#include "audiographer/sink.h"
+
+using namespace std;
+using namespace AudioGrapher;
+
+/* Compare libsamplerate and zita-resampler sample-rate conversion,
+ * as used for export: throughput and THD+N of a sine wave.
+ */
+
+static const int n_channels = 2;
+static const int duration   = 60;   // seconds
+static const int chunk      = 8192; // samples (all channels)
+
+class CollectingSink : public Sink<float>
+{
+  public:
+	void process (ProcessContext<float> const& c)
+	{
+		data.insert (data.end (), c.data (), c.data () + c.samples ());
+	}
+	using Sink<float>::process;
+
+	vector<float> data;
+};
+
+/* Least squares fit of a sine at the given frequency, returns
+ * the power ratio of the residual to the fitted sine in dB.
+ */
+static double
+thd_n (vector<float> const& data, int channels, double freq, double rate)
+{
+	size_t const n_frames = data.size () / channels;
+	/* skip edges, which are affected by the filter */
+	size_t const skip = rate / 10;
+
+	double ss = 0, sc = 0, cc = 0, ys = 0, yc = 0;
+	for (size_t i = skip; i + skip < n_frames; ++i) {
+		double const w = 2 * M_PI * freq * i / rate;
+		double const s = sin (w);
+		double const c = cos (w);
+		double const y = data[i * channels];
+		ss += s * s;
+		sc += s * c;
+		cc += c * c;
+		ys += y * s;
+		yc += y * c;
+	}
+
+	double const det = ss * cc - sc * sc;
+	double const a   = (ys * cc - yc * sc) / det;
+	double const b   = (yc * ss - ys * sc) / det;
+
+	double sig = 0, err = 0;
+	for (size_t i = skip; i + skip < n_frames; ++i) {
+		double const w = 2 * M_PI * freq * i / rate;
+		double const f = a * sin (w) + b * cos (w);
+		double const e = data[i * channels] - f;
+		sig += f * f;
+		err += e * e;
+	}
+	return 10 * log10 (err / sig);
+}
+
+static void
+run (int in_rate, int out_rate, int quality, char const* name)
+{
+	double const freqs[] = { 997, 15000 };
+
+	for (size_t f = 0; f < sizeof (freqs) / sizeof (double); ++f) {
+		SampleRateConverter src (n_channels);
+		src.init (in_rate, out_rate, quality);
+		src.allocate_buffers (chunk);
+
+		std::shared_ptr<CollectingSink> sink (new CollectingSink);
+		sink->data.reserve ((size_t) duration * out_rate * n_channels + chunk);
+		src.add_output (sink);
+
+		size_t const  n_samples = (size_t) duration * in_rate * n_channels;
+		vector<float> in (chunk);
+
+		PBD::microseconds_t total = 0;
+
+		for (size_t pos = 0; pos < n_samples; pos += chunk) {
+			samplecnt_t const n = min<size_t> (chunk, n_samples - pos);
+			for (samplecnt_t i = 0; i < n; ++i) {
+				in[i] = 0.89 * sin (2 * M_PI * freqs[f] * ((pos + i) / n_channels) / in_rate);
+			}
+			ProcessContext<float> c (&in[0], n, n_channels);
+			if (pos + n == n_samples) {
+				c.set_flag (ProcessContext<float>::EndOfInput);
+			}
+			PBD::microseconds_t t0 = PBD::get_microseconds ();
+			src.process (c);
+			total += PBD::get_microseconds () - t0;
+		}
+
+		printf ("  %-16s %6d -> %6d, %5.0f Hz: %8.1f x realtime, THD+N %7.1f dB\n",
+		        name, in_rate, out_rate, freqs[f], duration * 1e6 / total,
+		        thd_n (sink->data, n_channels, freqs[f], out_rate));
+	}
+}
+
+int
+main (int argc, char* argv[])
+{
+	PBD::init ();
+
+	int const rates[][2] = { { 96000, 48000 }, { 48000, 44100 }, { 44100, 96000 } };
+
+	cout << n_channels << " channels, " << duration << " seconds\n";
+
+	for (size_t r = 0; r < sizeof (rates) / sizeof (rates[0]); ++r) {
+		run (rates[r][0], rates[r][1], SRC_SINC_BEST_QUALITY, "SRC best");
+		run (rates[r][0], rates[r][1], SRC_SINC_MEDIUM_QUALITY, "SRC medium");
+		run (rates[r][0], rates[r][1], SampleRateConverter::ZitaQuality + 96, "zita 96");
+		run (rates[r][0], rates[r][1], SampleRateConverter::ZitaQuality + 48, "zita 48");
+		run (rates[r][0], rates[r][1], SampleRateConverter::ZitaQuality + 24, "zita 24");
+	}
+
+	return 0;
+}
@@ -0,0 +1,140 @@
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+
+#include <glibmm/miscutils.h>
+
+#include "pbd/compose.h"
+#include "pbd/failed_constructor.h"
+#include "pbd/microseconds.h"
+
+#include "ardour/ardour.h"
+#include "ardour/audioengine.h"
+#include "ardour/graph.h"
+#include "ardour/port.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/session.h"
+
+#include "test_ui.h"
+#include "test_util.h"
+
+using namespace std;
+using namespace ARDOUR;
+
+/* Cost of PortManager::cycle_start and ::cycle_end during varispeed, as a
+ * function of the number of ports. This compares sequential processing
+ * (one process thread) with the batches queued by
+ * PortManager::queue_port_batches on the session's process-threads.
+ */
+
+static const char* localedir = LOCALEDIR;
+
+/* PortManager::cycle_start and ::cycle_end are only meant to be called by
+ * the engine's process-callback, expose them for this benchmark.
+ */
+struct CycleAccess : public AudioEngine {
+	typedef void (PortManager::*CycleMethod) (pframes_t, Session*);
+	static CycleMethod cycle_start_method () { return &CycleAccess::cycle_start; }
+	static CycleMethod cycle_end_method () { return &CycleAccess::cycle_end; }
+};
+
+static const int    n_cycles = 2000;
+static const double speed    = 1.02;
+
+static double
+run_cycles (AudioEngine* engine, Session* s, pframes_t nframes)
+{
+	PBD::microseconds_t total = 0;
+
+	CycleAccess::CycleMethod cycle_start = CycleAccess::cycle_start_method ();
+	CycleAccess::CycleMethod cycle_end   = CycleAccess::cycle_end_method ();
+
+	for (int cycle = 0; cycle < n_cycles; ++cycle) {
+		/* The backend keeps calling the engine's process-callback,
+		 * which does nothing while we hold the process-lock. It does
+		 * however reset the varispeed ratio, so set it for every cycle.
+		 */
+		Glib::Threads::Mutex::Lock lm (engine->process_lock ());
+		PBD::microseconds_t t0 = PBD::get_microseconds ();
+
+		Port::set_varispeed_ratio (speed);
+		(engine->*cycle_start) (nframes, s);
+		Port::set_varispeed_ratio (speed);
+		(engine->*cycle_end) (nframes, s);
+
+		total += PBD::get_microseconds () - t0;
+	}
+	return total / (double) n_cycles;
+}
+
+static void
+set_process_threads (Session* s, int n)
+{
+	/* see how_many_dsp_threads() */
+	Config->set_processor_usage (n);
+	s->process_graph ()->reset_thread_list ();
+}
+
+int
+main (int argc, char* argv[])
+{
+	ARDOUR::init (true, localedir);
+	TestUI* test_ui = new TestUI ();
+	create_and_start_dummy_backend ();
+
+	AudioEngine* engine = AudioEngine::instance ();
+
+	Session* s = 0;
+	try {
+		s = new Session (*engine, Glib::build_filename (new_test_output_dir ("varispeed_ports"), "session"), "session");
+	} catch (failed_constructor& e) {
+		cerr << "failed_constructor: " << e.what () << "\n";
+		exit (EXIT_FAILURE);
+	}
+
+	if (!Port::can_varispeed ()) {
+		cerr << "Port resampling is not available\n";
+		exit (EXIT_FAILURE);
+	}
+
+	const pframes_t nframes       = engine->samples_per_cycle ();
+	const int       port_counts[] = { 4, 16, 64, 256, 512 };
+	const int       default_usage = Config->get_processor_usage ();
+
+	vector<std::shared_ptr<Port> > ports;
+
+	cout << "varispeed " << speed << ", " << nframes << " samples/cycle, average per cycle:\n";
+
+	for (size_t c = 0; c < sizeof (port_counts) / sizeof (int); ++c) {
+		/* half of the ports are inputs, the other half outputs */
+		while ((int) ports.size () < port_counts[c]) {
+			string const name = string_compose ("bench %1", ports.size ());
+			if (ports.size () % 2) {
+				ports.push_back (engine->register_output_port (DataType::AUDIO, name));
+			} else {
+				ports.push_back (engine->register_input_port (DataType::AUDIO, name));
+			}
+		}
+
+		set_process_threads (s, 1);
+		const double sequential = run_cycles (engine, s, nframes);
+
+		set_process_threads (s, default_usage);
+		const double batched = run_cycles (engine, s, nframes);
+
+		cout << "  " << ports.size () << " ports : sequential " << sequential << " us"
+		     << ", " << s->process_graph ()->n_threads () << " threads " << batched << " us\n";
+	}
+
+	for (auto const& p : ports) {
+		engine->unregister_port (p);
+	}
+	ports.clear ();
+
+	engine->remove_session ();
+	delete s;
+	engine->stop ();
+	delete test_ui;
+	ARDOUR::cleanup ();
+	return 0;
+}
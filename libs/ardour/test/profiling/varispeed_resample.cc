@@ -0,0 +1,89 @@
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "pbd/microseconds.h"
+#include "pbd/pbd.h"
+
+#include "zita-resampler/vmresampler.h"
+
+using namespace std;
+
+/* Cost of port resampling during varispeed, per process cycle, as a
+ * function of the number of channels. Each channel is resampled twice
+ * per cycle, like an AudioPort does in cycle_start and cycle_end.
+ */
+
+static const int    n_cycles = 2000;
+static const int    nframes  = 1024;
+static const int    quality  = 17; // Port::_resampler_quality
+static const double speed    = 1.02;
+
+int
+main (int argc, char* argv[])
+{
+	PBD::init ();
+
+	const int cycle_nframes = floor (nframes * speed);
+	const int channel_counts[] = { 1, 2, 8, 16, 32, 64, 128 };
+
+	vector<float> engine_buf (nframes + 1);
+	vector<float> port_buf (cycle_nframes + 1);
+
+	for (int i = 0; i < nframes; ++i) {
+		engine_buf[i] = sinf (i * 0.01f);
+	}
+
+	cout << "varispeed " << speed << ", " << nframes << " samples/cycle, average per cycle:\n";
+
+	for (size_t c = 0; c < sizeof (channel_counts) / sizeof (int); ++c) {
+		const int n_channels = channel_counts[c];
+
+		vector<ArdourZita::VMResampler*> in_src;
+		vector<ArdourZita::VMResampler*> out_src;
+
+		for (int n = 0; n < n_channels; ++n) {
+			in_src.push_back (new ArdourZita::VMResampler ());
+			out_src.push_back (new ArdourZita::VMResampler ());
+			in_src.back ()->setup (quality);
+			in_src.back ()->set_rrfilt (10);
+			out_src.back ()->setup (quality);
+			out_src.back ()->set_rrfilt (10);
+		}
+
+		PBD::microseconds_t total = 0;
+
+		for (int cycle = 0; cycle < n_cycles; ++cycle) {
+			PBD::microseconds_t t0 = PBD::get_microseconds ();
+			for (int n = 0; n < n_channels; ++n) {
+				ArdourZita::VMResampler* src = in_src[n];
+				src->inp_data  = &engine_buf[0];
+				src->inp_count = nframes;
+				src->out_count = cycle_nframes;
+				src->set_rratio (cycle_nframes / (double)nframes);
+				src->out_data  = &port_buf[0];
+				src->process ();
+
+				src = out_src[n];
+				src->inp_data  = &port_buf[0];
+				src->inp_count = cycle_nframes;
+				src->out_count = nframes;
+				src->set_rratio (nframes / (double)cycle_nframes);
+				src->out_data  = &engine_buf[0];
+				src->process ();
+			}
+			total += PBD::get_microseconds () - t0;
+		}
+
+		cout << "  " << n_channels << " channels : " << total / (double) n_cycles << " us"
+		     << " (" << total / (double) (n_cycles * n_channels) << " us/channel)\n";
+
+		for (int n = 0; n < n_channels; ++n) {
+			delete in_src[n];
+			delete out_src[n];
+		}
+	}
+
+	return 0;
+}
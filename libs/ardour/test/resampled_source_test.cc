@@ -14,6 +14,18 @@ using namespace PBD;
 
 void
 ResampledSourceTest::seekTest ()
+{
+	seek_test (SrcBest);
+}
+
+void
+ResampledSourceTest::seekTestZita ()
+{
+	seek_test (SrcZitaBest);
+}
+
+void
+ResampledSourceTest::seek_test (SrcQuality quality)
 {
 	std::string test_file_path;
 	const string test_filename = "test.wav";
@@ -21,7 +33,7 @@ ResampledSourceTest::seekTest ()
 	CPPUNIT_ASSERT (find_file (test_search_path (), test_filename, test_file_path));
 
 	std::shared_ptr<SndFileImportableSource> s (new SndFileImportableSource (test_file_path));
-	ResampledImportableSource r (s, 48000, SrcBest);
+	ResampledImportableSource r (s, 48000, quality);
 
 	/* Make sure that seek (0) has the desired effect, ie that
 	   given the same input you get the same output after seek (0)
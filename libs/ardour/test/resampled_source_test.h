@@ -1,12 +1,19 @@
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
 
+#include "ardour/types.h"
+
 class ResampledSourceTest : public CppUnit::TestFixture
 {
 	CPPUNIT_TEST_SUITE (ResampledSourceTest);
 	CPPUNIT_TEST (seekTest);
+	CPPUNIT_TEST (seekTestZita);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
 	void seekTest ();
+	void seekTestZita ();
+
+private:
+	void seek_test (ARDOUR::SrcQuality);
 };
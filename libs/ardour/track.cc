@@ -609,6 +609,12 @@ Track::capture_buffer_load () const
 	return _disk_writer->buffer_load ();
 }
 
+float
+Track::capture_buffer_min_load () const
+{
+	return _disk_writer->min_buffer_load ();
+}
+
 int
 Track::do_refill ()
 {
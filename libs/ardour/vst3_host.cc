@@ -673,7 +673,7 @@ HostApplication::createInstance (TUID cid, TUID _iid, void** obj)
 tresult
 Vst3ParamValueQueue::getPoint (int32 index, int32& sampleOffset, Vst::ParamValue& value)
 {
-	if (index >= 0 && index < (int32)_values.size ()) {
+	if (index >= 0 && index < _n_values) {
 		const Value& v = _values[index];
 		sampleOffset   = v.sampleOffset;
 		value          = v.value;
@@ -685,25 +685,40 @@ Vst3ParamValueQueue::getPoint (int32 index, int32& sampleOffset, Vst::ParamValue
 tresult
 Vst3ParamValueQueue::addPoint (int32 sampleOffset, Vst::ParamValue value, int32& index)
 {
-	int32 dest_index = (int32)_values.size ();
-	for (uint32 i = 0; i < _values.size (); ++i) {
-		if (_values[i].sampleOffset == sampleOffset) {
-			_values[i].value = value;
-			index            = i;
-			return kResultTrue;
-		} else if (_values[i].sampleOffset > sampleOffset) {
-			dest_index = i;
-			break;
+	int32 dest_index = _n_values;
+
+	/* automation events are usually added in chronological order */
+	if (_n_values > 0 && _values[_n_values - 1].sampleOffset >= sampleOffset) {
+		for (int32 i = 0; i < _n_values; ++i) {
+			if (_values[i].sampleOffset == sampleOffset) {
+				_values[i].value = value;
+				index            = i;
+				return kResultTrue;
+			} else if (_values[i].sampleOffset > sampleOffset) {
+				dest_index = i;
+				break;
+			}
 		}
 	}
 
-	Value v (value, sampleOffset);
-	if (dest_index == (int32)_values.size ()) {
-		_values.push_back (v);
-	} else {
-		_values.insert (_values.begin () + dest_index, v);
+	if (_n_values >= maxNumPoints) {
+		/* thin out dense automation: replace the preceding point.
+		 * This retains the order, and the last point of a cycle
+		 * (the value at cycle-end) is never dropped.
+		 */
+		dest_index = std::max<int32> (0, dest_index - 1);
+		_values[dest_index] = Value (value, sampleOffset);
+		index = dest_index;
+		return kResultTrue;
 	}
 
+	for (int32 i = _n_values; i > dest_index; --i) {
+		_values[i] = _values[i - 1];
+	}
+
+	_values[dest_index] = Value (value, sampleOffset);
+	++_n_values;
+
 	index = dest_index;
 	return kResultTrue;
 }
@@ -72,6 +72,50 @@ void Vumeterdsp::process (float const *p, int n)
 }
 
 
+/* Process four meters at once, using one SIMD lane per channel.
+ * The per-channel math is identical to process().
+ */
+void Vumeterdsp::process4 (Vumeterdsp *mtr, float const * const *p, int n)
+{
+    float z1[4], z2[4], m[4];
+
+    for (int c = 0; c < 4; ++c)
+    {
+	z1[c] = mtr[c]._z1 > 20 ? 20 : (mtr[c]._z1 < -20 ? -20 : mtr[c]._z1);
+	z2[c] = mtr[c]._z2 > 20 ? 20 : (mtr[c]._z2 < -20 ? -20 : mtr[c]._z2);
+	m[c] = mtr[c]._res ? 0 : mtr[c]._m;
+	mtr[c]._res = false;
+    }
+
+    n /= 4;
+    for (int i = 0; i < n; ++i)
+    {
+	for (int k = 4 * i; k < 4 * i + 4; ++k)
+	{
+	    for (int c = 0; c < 4; ++c)
+	    {
+		const float t1 = fabsf (p[c][k]) - z2[c] / 2;
+		z1[c] += _w * (t1 - z1[c]);
+	    }
+	}
+	for (int c = 0; c < 4; ++c)
+	{
+	    z2[c] += 4 * _w * (z1[c] - z2[c]);
+	    if (z2[c] > m[c]) m[c] = z2[c];
+	}
+    }
+
+    for (int c = 0; c < 4; ++c)
+    {
+	if (isnan(z1[c])) z1[c] = 0;
+	if (isnan(z2[c])) z2[c] = 0;
+	mtr[c]._z1 = z1[c];
+	mtr[c]._z2 = z2[c] + 1e-10f;
+	mtr[c]._m = m[c];
+    }
+}
+
+
 float Vumeterdsp::read (void)
 {
     _res = true;
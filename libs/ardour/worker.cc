@@ -20,10 +20,10 @@
 #include <stdlib.h>
 #include <unistd.h>
 
-#include <glibmm/timer.h>
+#include <algorithm>
 
 #include "pbd/error.h"
-#include "pbd/compose.h"
+#include "pbd/cpus.h"
 #include "pbd/pthread_utils.h"
 
 #include "ardour/worker.h"
@@ -35,22 +35,25 @@ Worker::Worker(Workee* workee, uint32_t ring_size, bool threaded)
 	, _requests(threaded ? new PBD::RingBuffer<uint8_t>(ring_size) : NULL)
 	, _responses(new PBD::RingBuffer<uint8_t>(ring_size))
 	, _response((uint8_t*)malloc(ring_size))
-	, _sem(string_compose ("worker_semaphore%1", this).c_str(), 0)
-	, _thread(NULL)
-	, _exit(false)
+	, _pool(threaded ? WorkerPool::acquire() : NULL)
 	, _synchronous(!threaded)
 {
-	if (threaded) {
-		_thread = PBD::Thread::create (std::bind (&Worker::run, this), "LV2Worker");
+	_scheduled.store (0);
+	_exit.store (false);
+
+	if (threaded && !_pool) {
+		PBD::warning << "Worker: cannot use worker thread-pool, work is processed synchronously" << endmsg;
+		_synchronous = true;
 	}
 }
 
 Worker::~Worker()
 {
 	_exit = true;
-	_sem.signal();
-	if (_thread) {
-		_thread->join();
+	if (_pool) {
+		/* wait for any work in progress, remaining requests are discarded */
+		_pool->wait_for (this);
+		WorkerPool::release ();
 	}
 	delete _responses;
 	delete _requests;
@@ -60,21 +63,36 @@ Worker::~Worker()
 bool
 Worker::schedule(uint32_t size, const void* data)
 {
-	if (_synchronous || !_requests) {
+	if (_synchronous || !_pool) {
 		_workee->work(*this, size, data);
 		emit_responses ();
 		return true;
 	}
-	if (_requests->write_space() < size + sizeof(size)) {
+
+	const PBD::microseconds_t now = PBD::get_microseconds ();
+
+	if (_requests->write_space() < size + sizeof(size) + sizeof(now)) {
 		return false;
 	}
 	if (_requests->write((const uint8_t*)&size, sizeof(size)) != sizeof(size)) {
 		return false;
 	}
+	if (_requests->write((const uint8_t*)&now, sizeof(now)) != sizeof(now)) {
+		return false;
+	}
 	if (_requests->write((const uint8_t*)data, size) != size) {
 		return false;
 	}
-	_sem.signal();
+
+	_pool->scheduled ();
+
+	/* only queue the worker once, the pool thread that processes
+	 * its requests re-queues it until all are handled. This retains
+	 * the order of requests.
+	 */
+	if (_scheduled.fetch_add (1) == 0) {
+		_pool->enqueue (this);
+	}
 	return true;
 }
 
@@ -135,53 +153,210 @@ Worker::emit_responses()
 }
 
 void
-Worker::run()
+Worker::process_requests (WorkerPool& pool, std::vector<uint8_t>& buf)
 {
-	void*  buf      = NULL;
-	size_t buf_size = 0;
-	while (true) {
-		_sem.wait();
-		if (_exit) {
-			free(buf);
-			return;
-		}
+	/* Requests are complete: the audio-thread writes a message
+	 * before incrementing _scheduled.
+	 *
+	 * Only process the requests that are pending now, a plugin that
+	 * schedules work every cycle must not keep this pool-thread busy.
+	 */
+	const uint32_t n_requests = _scheduled.load ();
+	assert (n_requests > 0);
 
-		uint32_t size = _requests->read_space();
-		if (size < sizeof(size)) {
-			PBD::error << "Worker: no work-data on ring buffer" << endmsg;
-			continue;
-		}
-		while (!verify_message_completeness(_requests)) {
-			Glib::usleep(2000);
-			if (_exit) {
-				if (buf) free(buf);
-				return;
-			}
+	for (uint32_t n = 0; n < n_requests; ++n) {
+		uint32_t            size = 0;
+		PBD::microseconds_t scheduled_at = 0;
+
+		_requests->read((uint8_t*)&size, sizeof(size));
+		_requests->read((uint8_t*)&scheduled_at, sizeof(scheduled_at));
+
+		if (buf.size () < size) {
+			buf.resize (size);
 		}
-		if (_requests->read((uint8_t*)&size, sizeof(size)) < sizeof(size)) {
-			PBD::error << "Worker: Error reading size from request ring"
-			           << endmsg;
-			continue;
+
+		if (_requests->read(buf.data (), size) < size) {
+			PBD::error << "Worker: Error reading body from request ring" << endmsg;
+		} else if (!_exit.load ()) {
+			_workee->work(*this, size, buf.data ());
 		}
 
-		if (size > buf_size) {
-			buf = realloc(buf, size);
-			if (buf) {
-				buf_size = size;
-			} else {
-				PBD::fatal << "Worker: Error allocating memory" << endmsg;
-				abort(); /*NOTREACHED*/
-			}
+		pool.done (scheduled_at);
+	}
+
+	if (_scheduled.fetch_sub (n_requests) > n_requests) {
+		/* more requests arrived meanwhile. The worker is still queued
+		 * only once (schedule() did not enqueue it), so the order of
+		 * requests is retained.
+		 */
+		pool.enqueue (this);
+		return;
+	}
+
+	/* this worker may be deleted from here on */
+	pool.finished ();
+}
+
+/* ****************************************************************************/
+
+Glib::Threads::Mutex WorkerPool::_instance_lock;
+WorkerPool*          WorkerPool::_instance = NULL;
+uint32_t             WorkerPool::_n_workers = 0;
+
+WorkerPool::WorkerPool ()
+	: _queue (16384)
+	, _sem ("worker_pool", 0)
+{
+	_quit.store (false);
+	_queued.store (0);
+	_max_queued.store (0);
+	_processed.store (0);
+	_total_latency.store (0);
+	_max_latency.store (0);
+
+	/* most work is I/O bound (loading files), a few threads suffice */
+	const uint32_t n_threads = std::max<uint32_t> (2, std::min<uint32_t> (hardware_concurrency (), 4));
+
+	for (uint32_t i = 0; i < n_threads; ++i) {
+		PBD::Thread* t = PBD::Thread::create (std::bind (&WorkerPool::run, this), "LV2Worker");
+		if (!t) {
+			break;
 		}
-		assert (buf);
+		_threads.push_back (t);
+	}
+}
 
-		if (_requests->read((uint8_t*)buf, size) < size) {
-			PBD::error << "Worker: Error reading body from request ring"
-			           << endmsg;
-			continue;  // TODO: This is probably fatal
+WorkerPool::~WorkerPool ()
+{
+	_quit = true;
+	for (std::vector<PBD::Thread*>::const_iterator i = _threads.begin (); i != _threads.end (); ++i) {
+		_sem.signal ();
+	}
+	for (std::vector<PBD::Thread*>::const_iterator i = _threads.begin (); i != _threads.end (); ++i) {
+		(*i)->join ();
+		delete *i;
+	}
+}
+
+WorkerPool*
+WorkerPool::acquire ()
+{
+	Glib::Threads::Mutex::Lock lm (_instance_lock);
+	if (!_instance) {
+		_instance = new WorkerPool ();
+	}
+	/* every worker is queued at most once */
+	if (_instance->_threads.empty () || _n_workers >= _instance->_queue.capacity ()) {
+		if (_n_workers == 0) {
+			delete _instance;
+			_instance = NULL;
 		}
+		return NULL;
+	}
+	++_n_workers;
+	return _instance;
+}
+
+void
+WorkerPool::release ()
+{
+	Glib::Threads::Mutex::Lock lm (_instance_lock);
+	assert (_n_workers > 0 && _instance);
+	if (--_n_workers == 0) {
+		delete _instance;
+		_instance = NULL;
+	}
+}
 
-		_workee->work(*this, size, buf);
+bool
+WorkerPool::get_stats (Stats& s)
+{
+	Glib::Threads::Mutex::Lock lm (_instance_lock);
+	if (!_instance) {
+		return false;
+	}
+	const uint64_t processed = _instance->_processed.load ();
+
+	s.n_threads   = _instance->_threads.size ();
+	s.n_workers   = _n_workers;
+	s.queued      = _instance->_queued.load ();
+	s.max_queued  = _instance->_max_queued.load ();
+	s.processed   = processed;
+	s.avg_latency = processed > 0 ? _instance->_total_latency.load () / processed : 0;
+	s.max_latency = _instance->_max_latency.load ();
+	return true;
+}
+
+void
+WorkerPool::reset_stats ()
+{
+	Glib::Threads::Mutex::Lock lm (_instance_lock);
+	if (!_instance) {
+		return;
+	}
+	_instance->_max_queued.store (_instance->_queued.load ());
+	_instance->_processed.store (0);
+	_instance->_total_latency.store (0);
+	_instance->_max_latency.store (0);
+}
+
+void
+WorkerPool::scheduled ()
+{
+	uint32_t queued = _queued.fetch_add (1) + 1;
+	uint32_t max    = _max_queued.load ();
+	while (queued > max && !_max_queued.compare_exchange_weak (max, queued)) ;
+}
+
+void
+WorkerPool::enqueue (Worker* w)
+{
+	/* cannot fail, the queue's capacity is larger than the number of workers */
+	_queue.push_back (w);
+	_sem.signal ();
+}
+
+void
+WorkerPool::done (PBD::microseconds_t scheduled_at)
+{
+	const uint64_t latency = std::max<PBD::microseconds_t> (0, PBD::get_microseconds () - scheduled_at);
+	uint64_t       max     = _max_latency.load ();
+
+	_queued.fetch_sub (1);
+	_processed.fetch_add (1);
+	_total_latency.fetch_add (latency);
+	while (latency > max && !_max_latency.compare_exchange_weak (max, latency)) ;
+}
+
+void
+WorkerPool::finished ()
+{
+	Glib::Threads::Mutex::Lock lm (_finished_lock);
+	_finished_cond.broadcast ();
+}
+
+void
+WorkerPool::wait_for (Worker* w)
+{
+	Glib::Threads::Mutex::Lock lm (_finished_lock);
+	while (w->_scheduled.load () > 0) {
+		_finished_cond.wait (_finished_lock);
+	}
+}
+
+void
+WorkerPool::run ()
+{
+	std::vector<uint8_t> buf;
+	while (true) {
+		_sem.wait ();
+		if (_quit.load ()) {
+			return;
+		}
+		Worker* w;
+		if (_queue.pop_front (w)) {
+			w->process_requests (*this, buf);
+		}
 	}
 }
 
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2010-2011 Fons Adriaensen <fons@linuxaudio.org>
+ * Copyright (C) 2016,2023 Robin Gareus <robin@gareus.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef AUDIOGRAPHER_LOUDNESS_METER_H
+#define AUDIOGRAPHER_LOUDNESS_METER_H
+
+#include <vector>
+
+#include "audiographer/visibility.h"
+#include "audiographer/types.h"
+
+namespace ArdourZita {
+	class Resampler;
+}
+
+namespace AudioGrapher
+{
+
+/** EBU R128 / ITU-R BS.1770 loudness and true-peak measurement.
+ *
+ * This is the common implementation used for export and region analysis
+ * (LoudnessReader, Analyser) as well as for realtime metering.
+ *
+ * The K-weighting filters of all channels are run in the same loop,
+ * several channels side by side, so that the recursive filters of
+ * different channels are computed in parallel (SIMD lanes).
+ * True-peak is measured on 4x (2x above 48kHz) oversampled data.
+ *
+ * All methods except the constructor are realtime-safe, unless
+ * true-peak positions are recorded.
+ */
+class LIBAUDIOGRAPHER_API LoudnessMeter
+{
+  public:
+	/** Gating histogram of loudness values in 0.1 LU steps, -70 to +5 LUFS.
+	 * Histograms of separate measurements (e.g. of consecutive segments)
+	 * can be merged.
+	 */
+	class LIBAUDIOGRAPHER_API Histogram
+	{
+	  public:
+		Histogram ();
+
+		void reset ();
+		void add (float loudness);
+		void merge (Histogram const&);
+
+		/** gated integrated loudness, -200 if there is not enough data */
+		float integrated () const;
+		/** loudness range (10% .. 95% of gated values) */
+		void  range (float* lo, float* hi) const;
+
+		int count () const { return _count; }
+		int bin (int i) const { return _bins[i]; }
+
+		static const int n_bins = 751;
+
+	  private:
+		float integrate (int) const;
+
+		int _bins[n_bins];
+		int _count;
+	};
+
+	LoudnessMeter (float sample_rate, unsigned int channels, bool true_peak = true);
+	~LoudnessMeter ();
+
+	void reset ();
+
+	/** process non-interleaved data */
+	void process (float const* const* data, samplecnt_t n_samples);
+	/** process interleaved data */
+	void process_interleaved (float const* data, samplecnt_t n_samples);
+
+	/** Combine the results of another measurement, as if its data had
+	 * been processed after the data of this one (e.g. a segment or
+	 * region that was analysed in a different thread).
+	 * Momentary and short-term loudness are not modified.
+	 */
+	void merge (LoudnessMeter const&);
+
+	float momentary () const      { return _loudness_M; }
+	float short_term () const     { return _loudness_S; }
+	float max_momentary () const  { return _maxloudn_M; }
+	float max_short_term () const { return _maxloudn_S; }
+	float integrated () const     { return _integrated; }
+	float loudness_range () const { return _range_max - _range_min; }
+
+	Histogram const& histogram_M () const { return _hist_M; }
+	Histogram const& histogram_S () const { return _hist_S; }
+
+	/** false if true-peak is not measured, either because it was not
+	 * requested, or because the oversampling could not be set up */
+	bool have_true_peak () const { return !_src.empty (); }
+	/** true peak (coefficient) of all channels */
+	float true_peak () const;
+	/** true peak (coefficient) of the given channel */
+	float true_peak (unsigned int chn) const { return _true_peak[chn]; }
+
+	/** Record positions of blocks that exceed -1dBTP, for each channel
+	 * (this allocates memory)
+	 */
+	void set_record_peak_positions (bool yn) { _record_peaks = yn; }
+	std::vector<samplecnt_t> const& peak_positions (unsigned int chn) const { return _peak_pos[chn]; }
+
+  private:
+	static const unsigned int lanes    = 4;
+	static const samplecnt_t  tp_block = 48;
+
+	struct FilterState {
+		float z1[lanes];
+		float z2[lanes];
+		float z3[lanes];
+		float z4[lanes];
+	};
+
+	void  run (float const* const* data, unsigned int stride, samplecnt_t n_samples);
+	float detect_process (float const* const* data, unsigned int stride, samplecnt_t offset, samplecnt_t n_samples);
+	template <unsigned int N>
+	float detect_group (float const* const* p, unsigned int n_channels, unsigned int stride, samplecnt_t n_samples, FilterState&, float const* gain) const;
+	float addfrags (int nfrag) const;
+	void  update_integration ();
+	void  true_peak_process (unsigned int chn, float const* data, unsigned int stride, samplecnt_t n_samples);
+
+	unsigned int _channels;
+	unsigned int _n_groups;
+
+	/* K-weighting */
+	float _a0, _a1, _a2;
+	float _b1, _b2;
+	float _c3, _c4;
+
+	std::vector<float>        _gain;
+	std::vector<FilterState>  _fst;
+	std::vector<float const*> _ptr;
+
+	/* loudness */
+	int   _fragm;
+	int   _frcnt;
+	float _frpwr;
+	float _power[64];
+	int   _wrind;
+	int   _div1;
+	int   _div2;
+
+	float _loudness_M;
+	float _maxloudn_M;
+	float _loudness_S;
+	float _maxloudn_S;
+	float _integrated;
+	float _range_min;
+	float _range_max;
+
+	Histogram _hist_M;
+	Histogram _hist_S;
+
+	/* true peak */
+	std::vector<ArdourZita::Resampler*>   _src;
+	unsigned int                          _tp_ratio;
+	std::vector<float>                    _tp_in;
+	std::vector<float>                    _tp_out;
+	std::vector<float>                    _true_peak;
+	bool                                  _record_peaks;
+	samplecnt_t                           _tp_pos;
+	std::vector<std::vector<samplecnt_t>> _peak_pos;
+};
+
+} // namespace
+
+#endif // AUDIOGRAPHER_LOUDNESS_METER_H
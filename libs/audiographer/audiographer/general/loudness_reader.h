@@ -19,13 +19,10 @@
 #ifndef AUDIOGRAPHER_LOUDNESS_READER_H
 #define AUDIOGRAPHER_LOUDNESS_READER_H
 
-#include <vector>
-
-#include <vamp-hostsdk/PluginLoader.h>
-
 #include "audiographer/visibility.h"
 #include "audiographer/sink.h"
 #include "audiographer/routines.h"
+#include "audiographer/general/loudness_meter.h"
 #include "audiographer/utils/listed_source.h"
 
 namespace AudioGrapher
@@ -42,19 +39,20 @@ class LIBAUDIOGRAPHER_API LoudnessReader : public ListedSource<float>, public Si
 	float calc_peak (float target_lufs = -23, float target_dbtp = -1) const;
 	bool  get_loudness (float* integrated, float* short_term = NULL, float* momentary = NULL) const;
 
+	LoudnessMeter const& meter () const { return _meter; }
+
 	virtual void process (ProcessContext<float> const & c);
 
 	using Sink<float>::process;
 
   protected:
-	Vamp::Plugin*              _ebur_plugin;
-	std::vector<Vamp::Plugin*> _dbtp_plugins;
+	LoudnessMeter _meter;
+	bool          _have_loudness; // only mono and stereo loudness is reported
 
 	float        _sample_rate;
 	unsigned int _channels;
 	samplecnt_t   _bufsize;
 	samplecnt_t   _pos;
-	float*       _bufs[2];
 };
 
 } // namespace
@@ -1,6 +1,8 @@
 #ifndef AUDIOGRAPHER_SR_CONVERTER_H
 #define AUDIOGRAPHER_SR_CONVERTER_H
 
+#include <vector>
+
 #include <samplerate.h>
 
 #include "audiographer/visibility.h"
@@ -10,10 +12,18 @@
 #include "audiographer/types.h"
 #include "audiographer/utils/listed_source.h"
 
+namespace ArdourZita
+{
+	class Resampler;
+}
+
 namespace AudioGrapher
 {
 
-/// Samplerate converter
+/** Samplerate converter.
+ * Uses libsamplerate, or zita-resampler for quality values
+ * ZitaQuality + h, with a filter half-length h of 16 to 96.
+ */
 class LIBAUDIOGRAPHER_API SampleRateConverter
   : public ListedSource<float>
   , public Sink<float>
@@ -25,7 +35,14 @@ class LIBAUDIOGRAPHER_API SampleRateConverter
 	SampleRateConverter (uint32_t channels);
 	~SampleRateConverter ();
 
-	/// Init converter \n Not RT safe
+	/// Quality values from this offset select the zita-resampler backend
+	static const int ZitaQuality = 0x100;
+
+	/** Init converter \n Not RT safe
+	  * @param quality libsamplerate converter type, or ZitaQuality + filter half-length.
+	  * zita-resampler requires a rational ratio, with a small enough denominator
+	  * (all common rates are fine), libsamplerate SRC_SINC_BEST_QUALITY is used otherwise.
+	  */
 	void init (samplecnt_t in_rate, samplecnt_t out_rate, int quality = 0);
 
 	/// Returns max amount of samples that will be output \n RT safe
@@ -44,6 +61,9 @@ class LIBAUDIOGRAPHER_API SampleRateConverter
 	void set_end_of_input (ProcessContext<float> const & c);
 	void reset ();
 
+	bool init_zita (samplecnt_t in_rate, samplecnt_t out_rate, unsigned int hlen);
+	void process_zita (ProcessContext<float> const & c, float const * in, samplecnt_t frames, bool last);
+
 	bool           active;
 	uint32_t       channels;
 	samplecnt_t     max_samples_in;
@@ -57,6 +77,14 @@ class LIBAUDIOGRAPHER_API SampleRateConverter
 
 	SRC_DATA       src_data;
 	SRC_STATE*     src_state;
+
+	/* zita-resampler, one per channel */
+	std::vector<ArdourZita::Resampler*> zita;
+	float *        zita_in;        // de-interleaved input, max_samples_in per channel
+	float *        zita_out;       // de-interleaved output, zita_out_frames per channel
+	samplecnt_t     zita_out_frames;
+	samplecnt_t     zita_in_total;  // samples per channel
+	samplecnt_t     zita_out_total; // samples per channel
 };
 
 } // namespace
@@ -0,0 +1,133 @@
+#ifndef AUDIOGRAPHER_TMP_FILE_MEM_H
+#define AUDIOGRAPHER_TMP_FILE_MEM_H
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "sndfile_writer.h"
+#include "sndfile_reader.h"
+#include "tmp_file.h"
+
+namespace AudioGrapher
+{
+
+/// Backing store of TmpFileMem, accessed by libsndfile's virtual I/O
+class MemoryFileStore
+{
+  public:
+	MemoryFileStore (size_t reserve_bytes)
+		: _pos (0)
+	{
+		_data.reserve (reserve_bytes);
+	}
+
+  protected:
+	static SF_VIRTUAL_IO* virtual_io ()
+	{
+		static SF_VIRTUAL_IO vio = { &vio_get_filelen, &vio_seek, &vio_read, &vio_write, &vio_tell };
+		return &vio;
+	}
+
+	void* store () { return this; }
+
+  private:
+	std::vector<char> _data;
+	sf_count_t        _pos;
+
+	static sf_count_t vio_get_filelen (void* user_data)
+	{
+		return static_cast<MemoryFileStore*> (user_data)->_data.size ();
+	}
+
+	static sf_count_t vio_seek (sf_count_t offset, int whence, void* user_data)
+	{
+		MemoryFileStore* self = static_cast<MemoryFileStore*> (user_data);
+		switch (whence) {
+			case SEEK_SET:
+				self->_pos = offset;
+				break;
+			case SEEK_CUR:
+				self->_pos += offset;
+				break;
+			case SEEK_END:
+				self->_pos = self->_data.size () + offset;
+				break;
+		}
+		self->_pos = std::max<sf_count_t> (0, self->_pos);
+		return self->_pos;
+	}
+
+	static sf_count_t vio_read (void* ptr, sf_count_t count, void* user_data)
+	{
+		MemoryFileStore* self = static_cast<MemoryFileStore*> (user_data);
+		sf_count_t const avail = std::max<sf_count_t> (0, (sf_count_t) self->_data.size () - self->_pos);
+		count = std::min (count, avail);
+		memcpy (ptr, self->_data.data () + self->_pos, count);
+		self->_pos += count;
+		return count;
+	}
+
+	static sf_count_t vio_write (const void* ptr, sf_count_t count, void* user_data)
+	{
+		MemoryFileStore* self = static_cast<MemoryFileStore*> (user_data);
+		if ((size_t)(self->_pos + count) > self->_data.size ()) {
+			self->_data.resize (self->_pos + count);
+		}
+		memcpy (self->_data.data () + self->_pos, ptr, count);
+		self->_pos += count;
+		return count;
+	}
+
+	static sf_count_t vio_tell (void* user_data)
+	{
+		return static_cast<MemoryFileStore*> (user_data)->_pos;
+	}
+};
+
+/** A temporary file that is kept in memory.
+ *
+ * This avoids a round-trip to disk when the data is small enough,
+ * e.g. for normalizing exports. \a reserve_bytes should be the expected size
+ * so that no reallocation is needed while writing.
+ */
+template<typename T = DefaultSampleType>
+class TmpFileMem
+	: public virtual MemoryFileStore
+	, public TmpFile<T>
+{
+  public:
+	/* The store is a virtual base listed first, so it is constructed
+	 * before the SndfileHandle, which may already access it.
+	 */
+	TmpFileMem (size_t reserve_bytes, int format, ChannelCount channels, samplecnt_t samplerate)
+		: MemoryFileStore (reserve_bytes)
+		, SndfileHandle (*MemoryFileStore::virtual_io (), MemoryFileStore::store (), SndfileBase::ReadWrite, format, channels, samplerate)
+	{}
+
+	using SndfileHandle::operator=;
+
+	~TmpFileMem()
+	{
+		SndfileBase::close();
+	}
+
+	void process (ProcessContext<T> const & c)
+	{
+		SndfileWriter<T>::process (c);
+
+		if (c.has_flag(ProcessContext<T>::EndOfInput)) {
+			TmpFile<T>::FileFlushed ();
+		}
+	}
+
+	using Sink<T>::process;
+
+  private:
+	TmpFileMem (TmpFileMem const & other) : MemoryFileStore (0), SndfileHandle (other) {}
+};
+
+} // namespace
+
+#endif // AUDIOGRAPHER_TMP_FILE_MEM_H
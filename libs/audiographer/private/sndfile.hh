@@ -83,6 +83,8 @@ class LIBAUDIOGRAPHER_API SndfileHandle
 							int format = 0, int channels = 0, int samplerate = 0) ;
 			SndfileHandle (int fd, bool close_desc, int mode = SFM_READ,
 							int format = 0, int channels = 0, int samplerate = 0) ;
+			SndfileHandle (SF_VIRTUAL_IO &sfvirtual, void *user_data, int mode = SFM_READ,
+							int format = 0, int channels = 0, int samplerate = 0) ;
 			~SndfileHandle (void) ;
 
 			SndfileHandle (const SndfileHandle &orig) ;
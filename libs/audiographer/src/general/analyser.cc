@@ -36,6 +36,8 @@ Analyser::Analyser (float sample_rate, unsigned int channels, samplecnt_t bufsiz
 	assert (bufsize > 1);
 	assert (_bufsize > 0);
 
+	_meter.set_record_peak_positions (true);
+
 	set_duration (n_samples);
 
 	_fft_data_size   = _bufsize / 2;
@@ -135,9 +137,6 @@ Analyser::process (ProcessContext<float> const & ctx)
 		for (unsigned int c = 0; c < _channels; ++c) {
 			const float v = *d;
 			if (fabsf(v) > _result.peak) { _result.peak = fabsf(v); }
-			if (c < _result.n_channels) {
-				_bufs[c][s] = v;
-			}
 			const unsigned int cc = c & cmask;
 			if (_result.peaks[cc][pbin].min > v) { _result.peaks[cc][pbin].min = *d; }
 			if (_result.peaks[cc][pbin].max < v) { _result.peaks[cc][pbin].max = *d; }
@@ -148,32 +147,20 @@ Analyser::process (ProcessContext<float> const & ctx)
 
 	for (; s < _bufsize; ++s) {
 		_fft_data_in[s] = 0;
-		for (unsigned int c = 0; c < _result.n_channels; ++c) {
-			_bufs[c][s] = 0.f;
-		}
 	}
 
-	if (_ebur_plugin) {
-		Vamp::Plugin::FeatureSet features = _ebur_plugin->process (_bufs, Vamp::RealTime::fromSeconds ((double) _pos / _sample_rate));
-		if (!features.empty ()) {
-			const samplecnt_t p0 = _pos / _spp;
-			const samplecnt_t p1 = (_pos + n_samples -1) / _spp;
-			for (samplecnt_t p = p0; p <= p1; ++p) {
-				assert (p >= 0 && p < (samplecnt_t) _result.width);
-				_result.lgraph_i[p] = features[0][0].values[0];
-				_result.lgraph_s[p] = features[0][1].values[0];
-				_result.lgraph_m[p] = features[0][2].values[0];
-			}
-			_result.have_lufs_graph = true;
-		}
-	}
+	_meter.process_interleaved (ctx.data (), n_samples);
 
-	float const * const data = ctx.data ();
-	for (unsigned int c = 0; c < _channels && c < _dbtp_plugins.size (); ++c) {
-		for (s = 0; s < n_samples; ++s) {
-			_bufs[0][s] = data[s * _channels + c];
+	if (_have_loudness) {
+		const samplecnt_t p0 = _pos / _spp;
+		const samplecnt_t p1 = (_pos + n_samples -1) / _spp;
+		for (samplecnt_t p = p0; p <= p1; ++p) {
+			assert (p >= 0 && p < (samplecnt_t) _result.width);
+			_result.lgraph_i[p] = _meter.integrated ();
+			_result.lgraph_s[p] = _meter.short_term ();
+			_result.lgraph_m[p] = _meter.momentary ();
 		}
-		_dbtp_plugins.at(c)->process (_bufs, Vamp::RealTime::fromSeconds ((double) _pos / _sample_rate));
+		_result.have_lufs_graph = true;
 	}
 
 	fftwf_execute (_fft_plan);
@@ -264,39 +251,34 @@ Analyser::result (bool ptr_only)
 		}
 	}
 
-	if (_ebur_plugin) {
-		Vamp::Plugin::FeatureSet features = _ebur_plugin->getRemainingFeatures ();
-		if (!features.empty () && features.size () == 3) {
-			_result.integrated_loudness    = features[0][0].values[0];
-			_result.max_loudness_short     = features[0][1].values[0];
-			_result.max_loudness_momentary = features[0][2].values[0];
-
-			_result.loudness_range = features[1][0].values[0];
-			assert (features[2][0].values.size () == 540);
-			for (int i = 0; i < 540; ++i) {
-				_result.loudness_hist[i] = features[2][0].values[i];
-				if (_result.loudness_hist[i] > _result.loudness_hist_max) {
-					_result.loudness_hist_max = _result.loudness_hist[i]; }
-			}
-			_result.have_loudness = true;
+	if (_have_loudness) {
+		_result.integrated_loudness    = _meter.integrated ();
+		_result.max_loudness_short     = _meter.max_short_term ();
+		_result.max_loudness_momentary = _meter.max_momentary ();
+		_result.loudness_range         = _meter.loudness_range ();
+
+		/* -59 .. -5 LUFS */
+		LoudnessMeter::Histogram const& hist (_meter.histogram_S ());
+		for (int i = 0; i < 540; ++i) {
+			_result.loudness_hist[i] = hist.bin (110 + i);
+			if (_result.loudness_hist[i] > _result.loudness_hist_max) {
+				_result.loudness_hist_max = _result.loudness_hist[i]; }
 		}
+		_result.have_loudness = true;
 	}
 
 	const unsigned cmask = _result.n_channels - 1; // [0, 1]
-	for (unsigned int c = 0; c < _channels && c < _dbtp_plugins.size (); ++c) {
-		Vamp::Plugin::FeatureSet features = _dbtp_plugins.at(c)->getRemainingFeatures ();
-		if (!features.empty () && features.size () == 2) {
-			_result.have_dbtp = true;
-			float p = features[0][0].values[0];
-			if (p > _result.truepeak) { _result.truepeak = p; }
-
-			for (std::vector<float>::const_iterator i = features[1][0].values.begin();
-					i != features[1][0].values.end(); ++i) {
-				/* re-scale - silence stripping: pk = (*i) * peaks / _pos; */
-				const samplecnt_t pk = (*i) * _n_samples / (_pos * _spp);
-				const unsigned int cc = c & cmask;
-				_result.truepeakpos[cc].insert (pk);
-			}
+	for (unsigned int c = 0; _meter.have_true_peak () && c < _channels; ++c) {
+		_result.have_dbtp = true;
+		float p = _meter.true_peak (c);
+		if (p > _result.truepeak) { _result.truepeak = p; }
+
+		std::vector<samplecnt_t> const& pos (_meter.peak_positions (c));
+		for (std::vector<samplecnt_t>::const_iterator i = pos.begin (); i != pos.end (); ++i) {
+			/* re-scale - silence stripping: pk = (*i) * peaks / _pos; */
+			const samplecnt_t pk = (*i) * _n_samples / (_pos * _spp);
+			const unsigned int cc = c & cmask;
+			_result.truepeakpos[cc].insert (pk);
 		}
 	}
 
@@ -0,0 +1,525 @@
+/*
+ * Copyright (C) 2010-2011 Fons Adriaensen <fons@linuxaudio.org>
+ * Copyright (C) 2016,2023 Robin Gareus <robin@gareus.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef COMPILER_MSVC
+#include <float.h>
+#define isfinite_local(val) (bool)_finite ((double)val)
+#else
+#define isfinite_local std::isfinite
+#endif
+
+#include "zita-resampler/resampler.h"
+
+#include "audiographer/general/loudness_meter.h"
+
+using namespace AudioGrapher;
+
+/* Histogram, based on Fons Adriaensen's ebu_r128_proc */
+
+static float const*
+bin_power ()
+{
+	static struct BinPower {
+		BinPower ()
+		{
+			for (int i = 0; i < 100; ++i) {
+				p[i] = powf (10.0f, i / 100.0f);
+			}
+		}
+		float p[100];
+	} const bp;
+	return bp.p;
+}
+
+LoudnessMeter::Histogram::Histogram ()
+{
+	reset ();
+}
+
+void
+LoudnessMeter::Histogram::reset ()
+{
+	memset (_bins, 0, sizeof (_bins));
+	_count = 0;
+}
+
+void
+LoudnessMeter::Histogram::add (float v)
+{
+	int k = (int)floorf (10 * v + 700.5f);
+	if (k < 0) {
+		return;
+	}
+	if (k >= n_bins) {
+		k = n_bins - 1;
+	}
+	_bins[k]++;
+	_count++;
+}
+
+void
+LoudnessMeter::Histogram::merge (Histogram const& other)
+{
+	for (int i = 0; i < n_bins; ++i) {
+		_bins[i] += other._bins[i];
+	}
+	_count += other._count;
+}
+
+float
+LoudnessMeter::Histogram::integrate (int i) const
+{
+	float const* bp = bin_power ();
+
+	int   j = i % 100;
+	int   n = 0;
+	float s = 0;
+
+	while (i < n_bins) {
+		int const k = _bins[i++];
+		n += k;
+		s += k * bp[j++];
+		if (j == 100) {
+			j = 0;
+			s /= 10.0f;
+		}
+	}
+	return s / n;
+}
+
+float
+LoudnessMeter::Histogram::integrated () const
+{
+	if (_count < 50) {
+		return -200.0f;
+	}
+	/* relative gate, -10 dB below the result of the first integration */
+	float s = integrate (0);
+	int   k = (int)(floorf (100 * log10f (s) + 0.5f)) + 600;
+	if (k < 0) {
+		k = 0;
+	}
+	return 10 * log10f (integrate (k));
+}
+
+void
+LoudnessMeter::Histogram::range (float* v0, float* v1) const
+{
+	if (_count < 20) {
+		*v0 = -200.0f;
+		*v1 = -200.0f;
+		return;
+	}
+
+	/* relative gate, -20 dB */
+	float s = integrate (0);
+	int   k = (int)(floorf (100 * log10f (s) + 0.5)) + 500;
+	if (k < 0) {
+		k = 0;
+	}
+
+	int i, j, n;
+	for (i = k, n = 0; i < n_bins; i++) {
+		n += _bins[i];
+	}
+
+	float const a = 0.10f * n;
+	float const b = 0.95f * n;
+
+	for (i = k, s = 0; s < a; i++) {
+		s += _bins[i];
+	}
+	for (j = n_bins - 1, s = n; s > b; j--) {
+		s -= _bins[j];
+	}
+	*v0 = (i - 701) / 10.0f;
+	*v1 = (j - 699) / 10.0f;
+}
+
+/* LoudnessMeter */
+
+const unsigned int LoudnessMeter::lanes;
+const samplecnt_t  LoudnessMeter::tp_block;
+
+LoudnessMeter::LoudnessMeter (float sample_rate, unsigned int channels, bool true_peak)
+	: _channels (channels)
+	, _n_groups ((channels + lanes - 1) / lanes)
+	, _gain (channels, 1.0f)
+	, _fst (_n_groups)
+	, _ptr (channels)
+	, _fragm (sample_rate / 20)
+	, _tp_ratio (sample_rate > 48000 ? 2 : 4)
+	, _true_peak (channels, 0.f)
+	, _record_peaks (false)
+	, _tp_pos (0)
+	, _peak_pos (channels)
+{
+	/* channel gains for L, R, C, Ls, Rs */
+	for (unsigned int c = 3; c < 5 && c < channels; ++c) {
+		_gain[c] = 1.41f;
+	}
+
+	/* K-weighting, shelf and highpass */
+	float a, b, c, d, r, u1, u2, w1, w2;
+
+	r  = 1 / tan (4712.3890f / sample_rate);
+	w1 = r / 1.12201f;
+	w2 = r * 1.12201f;
+	u1 = u2 = 1.4085f + 210.0f / sample_rate;
+
+	a = u1 * w1;
+	b = w1 * w1;
+	c = u2 * w2;
+	d = w2 * w2;
+
+	r   = 1 + a + b;
+	_a0 = (1 + c + d) / r;
+	_a1 = (2 - 2 * d) / r;
+	_a2 = (1 - c + d) / r;
+	_b1 = (2 - 2 * b) / r;
+	_b2 = (1 - a + b) / r;
+
+	r = 48.0f / sample_rate;
+	a = 4.9886075f * r;
+	b = 6.2298014f * r * r;
+	r = 1 + a + b;
+	a *= 2 / r;
+	b *= 4 / r;
+	_c3 = a + b;
+	_c4 = b;
+
+	r = 1.004995f / r;
+	_a0 *= r;
+	_a1 *= r;
+	_a2 *= r;
+
+	/* one resampler per channel, the mono filter is vectorized */
+	for (unsigned int c = 0; true_peak && c < channels; ++c) {
+		ArdourZita::Resampler* src = new ArdourZita::Resampler ();
+		if (src->setup (sample_rate, sample_rate * _tp_ratio, 1, 24, 1.0)) {
+			delete src;
+			break;
+		}
+		_src.push_back (src);
+	}
+
+	if (_src.size () != channels) {
+		for (auto& src : _src) {
+			delete src;
+		}
+		_src.clear ();
+	} else {
+		_tp_in.resize (tp_block);
+		_tp_out.resize (tp_block * _tp_ratio + 8);
+	}
+
+	reset ();
+}
+
+LoudnessMeter::~LoudnessMeter ()
+{
+	for (auto& src : _src) {
+		delete src;
+	}
+}
+
+void
+LoudnessMeter::reset ()
+{
+	for (auto& f : _fst) {
+		memset (&f, 0, sizeof (FilterState));
+	}
+
+	_frcnt = _fragm;
+	_frpwr = 1e-30f;
+	_wrind = 0;
+	_div1  = 0;
+	_div2  = 0;
+
+	memset (_power, 0, sizeof (_power));
+
+	_loudness_M = -200.0f;
+	_loudness_S = -200.0f;
+	_maxloudn_M = -200.0f;
+	_maxloudn_S = -200.0f;
+	_integrated = -200.0f;
+	_range_min  = -200.0f;
+	_range_max  = -200.0f;
+
+	_hist_M.reset ();
+	_hist_S.reset ();
+
+	std::fill (_true_peak.begin (), _true_peak.end (), 0.f);
+	for (auto& p : _peak_pos) {
+		p.clear ();
+	}
+	_tp_pos = 0;
+
+	for (auto& src : _src) {
+		src->reset ();
+	}
+}
+
+void
+LoudnessMeter::process (float const* const* data, samplecnt_t n_samples)
+{
+	run (data, 1, n_samples);
+
+	if (_src.empty ()) {
+		return;
+	}
+
+	for (unsigned int c = 0; c < _channels; ++c) {
+		true_peak_process (c, data[c], 1, n_samples);
+	}
+	_tp_pos += n_samples;
+}
+
+void
+LoudnessMeter::process_interleaved (float const* data, samplecnt_t n_samples)
+{
+	for (unsigned int c = 0; c < _channels; ++c) {
+		_ptr[c] = data + c;
+	}
+
+	run (&_ptr[0], _channels, n_samples);
+
+	if (_src.empty ()) {
+		return;
+	}
+
+	for (unsigned int c = 0; c < _channels; ++c) {
+		true_peak_process (c, data + c, _channels, n_samples);
+	}
+	_tp_pos += n_samples;
+}
+
+void
+LoudnessMeter::merge (LoudnessMeter const& other)
+{
+	_hist_M.merge (other._hist_M);
+	_hist_S.merge (other._hist_S);
+
+	_maxloudn_M = std::max (_maxloudn_M, other._maxloudn_M);
+	_maxloudn_S = std::max (_maxloudn_S, other._maxloudn_S);
+
+	for (unsigned int c = 0; c < _channels && c < other._channels; ++c) {
+		_true_peak[c] = std::max (_true_peak[c], other._true_peak[c]);
+	}
+
+	update_integration ();
+}
+
+float
+LoudnessMeter::true_peak () const
+{
+	float p = 0;
+	for (auto const& tp : _true_peak) {
+		p = std::max (p, tp);
+	}
+	return p;
+}
+
+void
+LoudnessMeter::run (float const* const* data, unsigned int stride, samplecnt_t n_samples)
+{
+	samplecnt_t off = 0;
+
+	while (n_samples > 0) {
+		samplecnt_t const k = std::min<samplecnt_t> (_frcnt, n_samples);
+
+		_frpwr += detect_process (data, stride, off, k);
+		_frcnt -= k;
+
+		if (_frcnt == 0) {
+			/* every 50 ms */
+			_power[_wrind++] = _frpwr / _fragm;
+			_frcnt           = _fragm;
+			_frpwr           = 1e-30f;
+			_wrind &= 63;
+
+			_loudness_M = addfrags (8);  // 400 ms
+			_loudness_S = addfrags (60); // 3 s
+
+			if (!isfinite_local (_loudness_M) || _loudness_M < -200.f) {
+				_loudness_M = -200.0f;
+			}
+			if (!isfinite_local (_loudness_S) || _loudness_S < -200.f) {
+				_loudness_S = -200.0f;
+			}
+
+			_maxloudn_M = std::max (_maxloudn_M, _loudness_M);
+			_maxloudn_S = std::max (_maxloudn_S, _loudness_S);
+
+			if (++_div1 == 2) {
+				_hist_M.add (_loudness_M);
+				_div1 = 0;
+			}
+			if (++_div2 == 10) {
+				_hist_S.add (_loudness_S);
+				_div2 = 0;
+				update_integration ();
+			}
+		}
+
+		off += k;
+		n_samples -= k;
+	}
+}
+
+float
+LoudnessMeter::detect_process (float const* const* data, unsigned int stride, samplecnt_t off, samplecnt_t n_samples)
+{
+	float        sum = 0;
+	unsigned int c0  = 0;
+
+	/* The filters are recursive, so a single channel cannot be
+	 * vectorized. Instead several channels are processed side by side.
+	 */
+	for (unsigned int g = 0; c0 < _channels; ++g) {
+		unsigned int const left = _channels - c0;
+		unsigned int const nc   = left < lanes ? left : lanes;
+
+		float const* p[lanes];
+		for (unsigned int l = 0; l < lanes; ++l) {
+			/* unused lanes duplicate the last channel */
+			p[l] = data[c0 + (l < nc ? l : nc - 1)] + off * stride;
+		}
+
+		if (nc > 2) {
+			sum += detect_group<4> (p, nc, stride, n_samples, _fst[g], &_gain[c0]);
+		} else if (nc == 2) {
+			sum += detect_group<2> (p, nc, stride, n_samples, _fst[g], &_gain[c0]);
+		} else {
+			sum += detect_group<1> (p, nc, stride, n_samples, _fst[g], &_gain[c0]);
+		}
+
+		c0 += nc;
+	}
+
+	return sum;
+}
+
+template <unsigned int N>
+float
+LoudnessMeter::detect_group (float const* const* p, unsigned int nc, unsigned int stride, samplecnt_t n_samples, FilterState& S, float const* gain) const
+{
+	float const a0 = _a0;
+	float const a1 = _a1;
+	float const a2 = _a2;
+	float const b1 = _b1;
+	float const b2 = _b2;
+	float const c3 = _c3;
+	float const c4 = _c4;
+
+	float z1[N], z2[N], z3[N], z4[N], s[N];
+
+	for (unsigned int l = 0; l < N; ++l) {
+		z1[l] = S.z1[l];
+		z2[l] = S.z2[l];
+		z3[l] = S.z3[l];
+		z4[l] = S.z4[l];
+		s[l]  = 0;
+	}
+
+	for (samplecnt_t j = 0; j < n_samples; ++j) {
+		samplecnt_t const o = j * stride;
+		for (unsigned int l = 0; l < N; ++l) {
+			float const x = p[l][o] - b1 * z1[l] - b2 * z2[l] + 1e-15f;
+			float const y = a0 * x + a1 * z1[l] + a2 * z2[l] - c3 * z3[l] - c4 * z4[l];
+			z2[l] = z1[l];
+			z1[l] = x;
+			z4[l] += z3[l];
+			z3[l] += y;
+			s[l] += y * y;
+		}
+	}
+
+	float sum = 0;
+	for (unsigned int l = 0; l < N; ++l) {
+		if (l < nc) {
+			sum += gain[l] * s[l];
+		}
+		S.z1[l] = !isfinite_local (z1[l]) ? 0 : z1[l];
+		S.z2[l] = !isfinite_local (z2[l]) ? 0 : z2[l];
+		S.z3[l] = !isfinite_local (z3[l]) ? 0 : z3[l];
+		S.z4[l] = !isfinite_local (z4[l]) ? 0 : z4[l];
+	}
+	return sum;
+}
+
+float
+LoudnessMeter::addfrags (int nfrag) const
+{
+	float s = 0;
+	int   k = (_wrind - nfrag) & 63;
+	for (int i = 0; i < nfrag; i++) {
+		s += _power[(i + k) & 63];
+	}
+	return -0.6976f + 10 * log10f (s / nfrag);
+}
+
+void
+LoudnessMeter::update_integration ()
+{
+	_integrated = _hist_M.integrated ();
+	_hist_S.range (&_range_min, &_range_max);
+}
+
+void
+LoudnessMeter::true_peak_process (unsigned int c, float const* data, unsigned int stride, samplecnt_t n_samples)
+{
+	ArdourZita::Resampler* src = _src[c];
+	unsigned int const     out_frames = _tp_out.size ();
+
+	for (samplecnt_t off = 0; off < n_samples; off += tp_block) {
+		samplecnt_t const k = std::min (tp_block, n_samples - off);
+
+		if (stride == 1) {
+			src->inp_data = const_cast<float*> (data + off);
+		} else {
+			for (samplecnt_t i = 0; i < k; ++i) {
+				_tp_in[i] = data[(off + i) * stride];
+			}
+			src->inp_data = &_tp_in[0];
+		}
+		src->inp_count = k;
+
+		float peak = 0;
+		while (src->inp_count > 0) {
+			src->out_count = out_frames;
+			src->out_data  = &_tp_out[0];
+			src->process ();
+
+			for (unsigned int i = 0; i < out_frames - src->out_count; ++i) {
+				peak = std::max (peak, fabsf (_tp_out[i]));
+			}
+		}
+
+		_true_peak[c] = std::max (_true_peak[c], peak);
+
+		if (_record_peaks && peak >= .89125f /* -1dBTP */) {
+			_peak_pos[c].push_back (_tp_pos + off + k);
+		}
+	}
+}
@@ -20,11 +20,14 @@
 
 #include "pbd/compose.h"
 
+#include "zita-resampler/resampler.h"
+
 #include "audiographer/general/sr_converter.h"
 
 #include "audiographer/exception.h"
 #include "audiographer/type_utils.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace AudioGrapher
@@ -40,6 +43,11 @@ SampleRateConverter::SampleRateConverter (uint32_t channels)
   , data_out (0)
   , data_out_size (0)
   , src_state (0)
+  , zita_in (0)
+  , zita_out (0)
+  , zita_out_frames (0)
+  , zita_in_total (0)
+  , zita_out_total (0)
 {
 	add_supported_flag (ProcessContext<>::EndOfInput);
 }
@@ -55,6 +63,15 @@ SampleRateConverter::init (samplecnt_t in_rate, samplecnt_t out_rate, int qualit
 	}
 
 	active = true;
+	src_data.src_ratio = (double) out_rate / (double) in_rate;
+
+	if (quality >= ZitaQuality) {
+		if (init_zita (in_rate, out_rate, quality - ZitaQuality)) {
+			return;
+		}
+		quality = SRC_SINC_BEST_QUALITY;
+	}
+
 	int err;
 	src_state = src_new (quality, channels, &err);
 	if (throw_level (ThrowObject) && !src_state) {
@@ -62,8 +79,28 @@ SampleRateConverter::init (samplecnt_t in_rate, samplecnt_t out_rate, int qualit
 				("Cannot initialize sample rate converter: %1",
 				 src_strerror (err)));
 	}
+}
 
-	src_data.src_ratio = (double) out_rate / (double) in_rate;
+bool
+SampleRateConverter::init_zita (samplecnt_t in_rate, samplecnt_t out_rate, unsigned int hlen)
+{
+	/* Use one resampler per channel, the single channel case is vectorized */
+	for (uint32_t c = 0; c < channels; ++c) {
+		ArdourZita::Resampler* r = new ArdourZita::Resampler ();
+		zita.push_back (r);
+		if (r->setup (in_rate, out_rate, 1, hlen)) {
+			reset ();
+			active = true;
+			return false;
+		}
+		/* pre-fill with zeros, to align input and output */
+		r->inp_count = r->inpsize () / 2 - 1;
+		r->inp_data  = 0;
+		r->out_count = 1;
+		r->out_data  = 0;
+		r->process ();
+	}
+	return true;
 }
 
 SampleRateConverter::~SampleRateConverter ()
@@ -76,6 +113,23 @@ SampleRateConverter::allocate_buffers (samplecnt_t max_samples)
 {
 	if (!active) { return max_samples; }
 
+	if (!zita.empty ()) {
+		samplecnt_t max_frames_in = max_samples / channels;
+		zita_out_frames = (samplecnt_t) ceil (max_frames_in * src_data.src_ratio) + 1;
+
+		if (data_out_size < zita_out_frames * channels) {
+			delete[] data_out;
+			delete[] zita_in;
+			delete[] zita_out;
+			data_out = new float[zita_out_frames * channels];
+			zita_in  = new float[max_frames_in * channels];
+			zita_out = new float[zita_out_frames * channels];
+			max_samples_in = max_samples;
+			data_out_size = zita_out_frames * channels;
+		}
+		return zita_out_frames * channels;
+	}
+
 	samplecnt_t max_samples_out = (samplecnt_t) ceil (max_samples * src_data.src_ratio);
 	max_samples_out -= max_samples_out % channels;
 
@@ -117,6 +171,16 @@ SampleRateConverter::process (ProcessContext<float> const & c)
 				 samples, max_samples_in));
 	}
 
+	if (!zita.empty ()) {
+		bool const end = c.has_flag (ProcessContext<float>::EndOfInput);
+		process_zita (c, in, samples / channels, false);
+		if (end) {
+			/* flush, the resampler delays the signal by half the filter length */
+			process_zita (c, 0, zita[0]->inpsize () / 2, true);
+		}
+		return;
+	}
+
 	int err;
 	bool first_time = true;
 
@@ -201,6 +265,64 @@ SampleRateConverter::process (ProcessContext<float> const & c)
 	}
 }
 
+/** Resample frames of input, or silence if in is NULL, and output the result.
+ * If last is set, output is limited to the length that corresponds
+ * to the total input, and the final output has the EndOfInput flag.
+ */
+void
+SampleRateConverter::process_zita (ProcessContext<float> const & c, float const * in, samplecnt_t frames, bool last)
+{
+	samplecnt_t const max_frames_in = max_samples_in / channels;
+
+	for (uint32_t ch = 0; ch < channels; ++ch) {
+		float* buf = &zita_in[ch * max_frames_in];
+		if (in) {
+			for (samplecnt_t i = 0; i < frames; ++i) {
+				buf[i] = in[i * channels + ch];
+			}
+		}
+		zita[ch]->inp_data  = in ? buf : 0;
+		zita[ch]->inp_count = frames;
+	}
+
+	if (in) {
+		zita_in_total += frames;
+	}
+
+	samplecnt_t const limit = (samplecnt_t) ceil (zita_in_total * src_data.src_ratio);
+
+	do {
+		for (uint32_t ch = 0; ch < channels; ++ch) {
+			zita[ch]->out_data  = &zita_out[ch * zita_out_frames];
+			zita[ch]->out_count = zita_out_frames;
+			zita[ch]->process ();
+		}
+
+		samplecnt_t n = zita_out_frames - zita[0]->out_count;
+		if (last) {
+			n = std::max<samplecnt_t> (0, std::min (n, limit - zita_out_total));
+		}
+
+		for (uint32_t ch = 0; ch < channels; ++ch) {
+			float const* buf = &zita_out[ch * zita_out_frames];
+			for (samplecnt_t i = 0; i < n; ++i) {
+				data_out[i * channels + ch] = buf[i];
+			}
+		}
+		zita_out_total += n;
+
+		bool const done = zita[0]->inp_count == 0;
+
+		ProcessContext<float> c_out (c, data_out, n * channels);
+		if (!last || !done) {
+			c_out.remove_flag (ProcessContext<float>::EndOfInput);
+		}
+		if (n > 0 || (last && done)) {
+			output (c_out);
+		}
+	} while (zita[0]->inp_count > 0);
+}
+
 void SampleRateConverter::set_end_of_input (ProcessContext<float> const & c)
 {
 	src_data.end_of_input = true;
@@ -226,12 +348,26 @@ void SampleRateConverter::reset ()
 
 	if (src_state) {
 		src_delete (src_state);
+		src_state = 0;
+	}
+
+	for (std::vector<ArdourZita::Resampler*>::iterator i = zita.begin (); i != zita.end (); ++i) {
+		delete *i;
 	}
+	zita.clear ();
+	delete [] zita_in;
+	delete [] zita_out;
+	zita_in = 0;
+	zita_out = 0;
+	zita_out_frames = 0;
+	zita_in_total = 0;
+	zita_out_total = 0;
 
 	leftover_samples = 0;
 	max_leftover_samples = 0;
 	if (leftover_data) {
 		free (leftover_data);
+		leftover_data = 0;
 	}
 
 	data_out_size = 0;
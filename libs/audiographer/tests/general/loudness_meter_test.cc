@@ -0,0 +1,139 @@
+#include "tests/utils.h"
+
+#include "audiographer/general/loudness_meter.h"
+
+using namespace AudioGrapher;
+
+class LoudnessMeterTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE (LoudnessMeterTest);
+  CPPUNIT_TEST (testSine);
+  CPPUNIT_TEST (testInterleaved);
+  CPPUNIT_TEST (testMerge);
+  CPPUNIT_TEST (testNoTruePeak);
+  CPPUNIT_TEST (testTruePeak);
+  CPPUNIT_TEST_SUITE_END ();
+
+  public:
+	void setUp()
+	{
+		rate    = 48000;
+		samples = rate * 20;
+		left    = new float[samples];
+		right   = new float[samples];
+
+		/* EBU Tech 3341, test case 1: 1kHz, -23 dBFS, stereo */
+		const float amp = powf (10.f, -23.f / 20.f);
+		for (samplecnt_t i = 0; i < samples; ++i) {
+			left[i] = right[i] = amp * sinf (2.f * M_PI * 1000.f * i / rate);
+		}
+	}
+
+	void tearDown()
+	{
+		delete [] left;
+		delete [] right;
+	}
+
+	void testSine()
+	{
+		LoudnessMeter meter (rate, 2);
+		process (meter, 0, samples);
+
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.f, meter.integrated (), .1f);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.f, meter.short_term (), .1f);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.f, meter.momentary (), .1f);
+
+		meter.reset ();
+		CPPUNIT_ASSERT (meter.integrated () < -70.f);
+	}
+
+	void testInterleaved()
+	{
+		float* data = new float[samples * 2];
+		for (samplecnt_t i = 0; i < samples; ++i) {
+			data[2 * i]     = left[i];
+			data[2 * i + 1] = right[i];
+		}
+
+		LoudnessMeter planar (rate, 2);
+		LoudnessMeter interleaved (rate, 2);
+		process (planar, 0, samples);
+		for (samplecnt_t pos = 0; pos < samples; pos += 1000) {
+			interleaved.process_interleaved (&data[2 * pos], std::min<samplecnt_t> (1000, samples - pos));
+		}
+		delete [] data;
+
+		CPPUNIT_ASSERT_EQUAL (planar.integrated (), interleaved.integrated ());
+		CPPUNIT_ASSERT_EQUAL (planar.max_short_term (), interleaved.max_short_term ());
+		CPPUNIT_ASSERT_EQUAL (planar.true_peak (), interleaved.true_peak ());
+	}
+
+	void testMerge()
+	{
+		/* second half is 6dB quieter */
+		for (samplecnt_t i = samples / 2; i < samples; ++i) {
+			left[i]  *= .5f;
+			right[i] *= .5f;
+		}
+
+		LoudnessMeter whole (rate, 2);
+		LoudnessMeter first (rate, 2);
+		LoudnessMeter second (rate, 2);
+		process (whole, 0, samples);
+		process (first, 0, samples / 2);
+		process (second, samples / 2, samples / 2);
+
+		first.merge (second);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (whole.integrated (), first.integrated (), .1f);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (whole.max_momentary (), first.max_momentary (), .1f);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (whole.true_peak (), first.true_peak (), 1e-4f);
+	}
+
+	void testNoTruePeak()
+	{
+		LoudnessMeter meter (rate, 2, false);
+		CPPUNIT_ASSERT (!meter.have_true_peak ());
+		process (meter, 0, samples);
+
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.f, meter.integrated (), .1f);
+		CPPUNIT_ASSERT_EQUAL (0.f, meter.true_peak ());
+	}
+
+	void testTruePeak()
+	{
+		/* fs/4 sine, with samples at +/- 45 degrees, 10ms fade-in */
+		for (samplecnt_t i = 0; i < samples; ++i) {
+			const float g = std::min (1.f, i / (.01f * rate));
+			left[i] = right[i] = g * .5f * sinf (M_PI * (2 * i + 1) / 4.f);
+		}
+
+		LoudnessMeter meter (rate, 2);
+		CPPUNIT_ASSERT (meter.have_true_peak ());
+		meter.set_record_peak_positions (true);
+		process (meter, 0, samples);
+
+		/* sample-peak is -9dBFS, BS.1770 allows for a small over-read */
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (.5f, meter.true_peak (), .03f);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (.5f, meter.true_peak (1), .03f);
+		CPPUNIT_ASSERT (meter.true_peak () > fabsf (left[samples - 1]) * 1.4f);
+		CPPUNIT_ASSERT (meter.peak_positions (0).empty ());
+	}
+
+  private:
+	void process (LoudnessMeter& meter, samplecnt_t start, samplecnt_t n_samples)
+	{
+		const samplecnt_t block = 1024;
+		for (samplecnt_t pos = start; pos < start + n_samples; pos += block) {
+			float const* data[2] = { &left[pos], &right[pos] };
+			meter.process (data, std::min (block, start + n_samples - pos));
+		}
+	}
+
+	float       rate;
+	samplecnt_t samples;
+	float*      left;
+	float*      right;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION (LoudnessMeterTest);
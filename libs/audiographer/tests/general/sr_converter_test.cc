@@ -1,3 +1,5 @@
+#include <cmath>
+
 #include "tests/utils.h"
 
 #include "audiographer/general/sr_converter.h"
@@ -11,6 +13,8 @@ class SampleRateConverterTest : public CppUnit::TestFixture
   CPPUNIT_TEST (testUpsampleLength);
   CPPUNIT_TEST (testDownsampleLength);
   CPPUNIT_TEST (testRespectsEndOfInput);
+  CPPUNIT_TEST (testZitaLength);
+  CPPUNIT_TEST (testZitaSine);
   CPPUNIT_TEST_SUITE_END ();
 
   public:
@@ -117,6 +121,65 @@ class SampleRateConverterTest : public CppUnit::TestFixture
 	}
 
 
+	void testZitaLength()
+	{
+		samplecnt_t const chunk = 32;
+
+		converter.reset (new SampleRateConverter (2));
+		converter->init (44100, 48000, SampleRateConverter::ZitaQuality + 32);
+		converter->allocate_buffers (chunk);
+		converter->add_output (grabber);
+
+		for (samplecnt_t s = 0; s < samples; s += chunk) {
+			ProcessContext<float> c (&random_data[s], chunk, 2);
+			if (s + chunk == samples) {
+				c.set_flag (ProcessContext<float>::EndOfInput);
+			}
+			converter->process (c);
+		}
+
+		samplecnt_t samples_output = 0;
+		for (std::list<ProcessContext<float> >::iterator it = grabber->contexts.begin(); it != grabber->contexts.end(); ++it) {
+			std::list<ProcessContext<float> >::iterator next = it; ++next;
+			CPPUNIT_ASSERT_EQUAL (next == grabber->contexts.end(), it->has_flag (ProcessContext<float>::EndOfInput));
+			samples_output += it->samples();
+		}
+
+		/* 64 samples per channel in, output is 64 * 48000 / 44100 rounded up */
+		CPPUNIT_ASSERT_EQUAL ((samplecnt_t) 2 * 70, samples_output);
+	}
+
+	void testZitaSine()
+	{
+		samplecnt_t const n_samples = 8192;
+		samplecnt_t const chunk     = 1024;
+		float* sine = new float[n_samples];
+		for (samplecnt_t i = 0; i < n_samples; ++i) {
+			sine[i] = 0.5f * sinf (2.f * M_PI * 1000.f * i / 96000.f);
+		}
+
+		converter->init (96000, 48000, SampleRateConverter::ZitaQuality + 48);
+		converter->allocate_buffers (chunk);
+		converter->add_output (sink);
+
+		for (samplecnt_t s = 0; s < n_samples; s += chunk) {
+			ProcessContext<float> c (&sine[s], chunk, 1);
+			if (s + chunk == n_samples) {
+				c.set_flag (ProcessContext<float>::EndOfInput);
+			}
+			converter->process (c);
+		}
+		delete [] sine;
+
+		CPPUNIT_ASSERT_EQUAL (n_samples / 2, (samplecnt_t) sink->get_data().size());
+
+		/* output is aligned with the input */
+		float const* out = sink->get_array();
+		for (samplecnt_t i = 64; i < n_samples / 2 - 64; ++i) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (0.5f * sinf (2.f * M_PI * 1000.f * i / 48000.f), out[i], 1e-4);
+		}
+	}
+
   private:
 	std::shared_ptr<SampleRateConverter > converter;
 	std::shared_ptr<AppendingVectorSink<float> > sink;
@@ -1890,8 +1890,9 @@ AlsaAudioBackend::main_process_thread ()
 				}
 				pthread_mutex_unlock (&_device_port_mutex);
 
+				/* clear the ports' own buffers; get_buffer () may return the buffer of a connected capture port */
 				for (std::vector<BackendPortPtr>::const_iterator it = _system_outputs.begin (); it != _system_outputs.end (); ++it) {
-					memset ((*it)->get_buffer (_samples_per_period), 0, _samples_per_period * sizeof (Sample));
+					memset (static_cast<AlsaAudioPort*> (it->get ())->buffer (), 0, _samples_per_period * sizeof (Sample));
 				}
 
 				/* call engine process callback */
@@ -2263,6 +2264,11 @@ AlsaAudioPort::get_buffer (pframes_t n_samples)
 		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
 		if (it == connections.end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
+		} else if (connections.size () == 1) {
+			/* single source, use its buffer directly, no copy needed */
+			std::shared_ptr<const AlsaAudioPort> source = std::dynamic_pointer_cast<const AlsaAudioPort> (*it);
+			assert (source && source->is_output ());
+			return const_cast<Sample*> (source->const_buffer ());
 		} else {
 			std::shared_ptr<const AlsaAudioPort> source = std::dynamic_pointer_cast<const AlsaAudioPort> (*it);
 			assert (source && source->is_output ());
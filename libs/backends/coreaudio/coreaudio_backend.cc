@@ -1420,9 +1420,9 @@ CoreAudioBackend::process_callback (const uint32_t n_samples, const uint64_t hos
 		_pcmio->get_capture_channel (i, (float*)(*it)->get_buffer(n_samples), n_samples);
 	}
 
-	/* clear output buffers */
+	/* clear output buffers, get_buffer () may return the buffer of a connected capture port */
 	for (std::vector<BackendPortPtr>::const_iterator it = _system_outputs.begin (); it != _system_outputs.end (); ++it) {
-		memset ((*it)->get_buffer (n_samples), 0, n_samples * sizeof (Sample));
+		memset (static_cast<CoreAudioPort*> (it->get ())->buffer (), 0, n_samples * sizeof (Sample));
 	}
 
 	if (engine.process_callback (n_samples)) {
@@ -1611,6 +1611,11 @@ CoreAudioPort::get_buffer (pframes_t n_samples)
 		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
 		if (it == connections.end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
+		} else if (connections.size () == 1) {
+			/* single source, use its buffer directly, no copy needed */
+			std::shared_ptr<const CoreAudioPort> source = std::dynamic_pointer_cast<const CoreAudioPort>(*it);
+			assert (source && source->is_output ());
+			return const_cast<Sample*> (source->const_buffer ());
 		} else {
 			std::shared_ptr<const CoreAudioPort> source = std::dynamic_pointer_cast<const CoreAudioPort>(*it);
 			assert (source && source->is_output ());
@@ -67,6 +67,7 @@ DummyAudioBackend::DummyAudioBackend (AudioEngine& e, AudioBackendInfo& info)
 	, _freewheeling (false)
 	, _realtime (false)
 	, _speedup (1.0)
+	, _report_xruns (false)
 	, _device ("")
 	, _samplerate (48000)
 	, _samples_per_period (1024)
@@ -78,6 +79,10 @@ DummyAudioBackend::DummyAudioBackend (AudioEngine& e, AudioBackendInfo& info)
 	, _midi_mode (MidiNoEvents)
 	, _systemic_input_latency (0)
 	, _systemic_output_latency (0)
+	, _aliased_bytes (0)
+	, _aliased_bytes_per_cycle (0)
+	, _aliased_bytes_total (0)
+	, _n_cycles (0)
 	, _processed_samples (0)
 {
 	_instance_name = s_instance_name;
@@ -93,6 +98,8 @@ DummyAudioBackend::DummyAudioBackend (AudioEngine& e, AudioBackendInfo& info)
 		_driver_speed.push_back (DriverSpeed (_("15x Speed"),    0.06666f));
 		_driver_speed.push_back (DriverSpeed (_("20x Speed"),    0.05f));
 		_driver_speed.push_back (DriverSpeed (_("50x Speed"),    0.02f));
+		/* no pacing, process cycles back to back (benchmarks). Keep this last */
+		_driver_speed.push_back (DriverSpeed (_("Unlimited Speed"), 0.0f));
 	}
 
 }
@@ -430,6 +437,9 @@ DummyAudioBackend::_start (bool /*for_latency_measurement*/)
 	engine.reconnect_ports ();
 	_port_change_flag.store (0);
 
+	/* only benchmarks want to know about cycles exceeding the period */
+	_report_xruns = NULL != getenv ("ARDOUR_DUMMY_XRUNS");
+
 	bool ok = _realtime;
 	if (_realtime && pbd_realtime_pthread_create ("Dummy Main", PBD_SCHED_FIFO, PBD_RT_PRI_MAIN, PBD_RT_STACKSIZE_PROC, &_main_thread, pthread_process, this)) {
 		PBD::warning << _("DummyAudioBackend: failed to acquire realtime permissions.") << endmsg;
@@ -464,6 +474,8 @@ DummyAudioBackend::stop ()
 		PBD::error << _("DummyAudioBackend: failed to terminate.") << endmsg;
 		return -1;
 	}
+	DEBUG_TRACE (PBD::DEBUG::BackendPorts, string_compose ("DummyAudioBackend: port buffer aliasing avoided copying %1 bytes/cycle on average over %2 cycles.\n",
+	                                                       _n_cycles > 0 ? _aliased_bytes_total / _n_cycles : 0, _n_cycles));
 	unregister_ports();
 	return 0;
 }
@@ -902,6 +914,9 @@ DummyAudioBackend::main_process_thread ()
 	AudioEngine::thread_init_callback (this);
 	_running = true;
 	_processed_samples = 0;
+	_aliased_bytes = 0;
+	_aliased_bytes_total = 0;
+	_n_cycles = 0;
 
 	manager.registration_callback();
 	manager.graph_order_callback();
@@ -961,6 +976,10 @@ DummyAudioBackend::main_process_thread ()
 			}
 		}
 
+		_aliased_bytes_per_cycle = _aliased_bytes.exchange (0);
+		_aliased_bytes_total += _aliased_bytes_per_cycle;
+		++_n_cycles;
+
 		if (!_freewheel) {
 			_dsp_load_calc.set_max_time (_samplerate, samples_per_period);
 			_dsp_load_calc.set_start_timestamp_us (clock1);
@@ -973,6 +992,10 @@ DummyAudioBackend::main_process_thread ()
 				const int64_t sleepy = _speedup * (nominal_time - elapsed_time);
 				Glib::usleep (std::max ((int64_t) 10, sleepy));
 			} else {
+				if (_report_xruns && _speedup >= 1.f) {
+					/* processing took longer than a period */
+					engine.Xrun ();
+				}
 				Glib::usleep (10); // don't hog cpu
 			}
 		} else {
@@ -1595,6 +1618,15 @@ DummyAudioPort::get_buffer (pframes_t n_samples)
 		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
 		if (it == connections.end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
+		} else if (connections.size () == 1) {
+			/* single source, use its buffer directly, no copy needed */
+			std::shared_ptr<DummyAudioPort> source = std::dynamic_pointer_cast<DummyAudioPort>(*it);
+			assert (source && source->is_output ());
+			if (source->is_physical() && source->is_terminal()) {
+				source->get_buffer(n_samples); // generate signal.
+			}
+			engine ().count_aliased_buffer (n_samples * sizeof (Sample));
+			return source->buffer ();
 		} else {
 			std::shared_ptr<DummyAudioPort> source = std::dynamic_pointer_cast<DummyAudioPort>(*it);
 			assert (source && source->is_output ());
@@ -20,6 +20,7 @@
 #ifndef __libbackend_dummy_audiobackend_h__
 #define __libbackend_dummy_audiobackend_h__
 
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -83,13 +84,14 @@ class DummyPort : public BackendPort {
 		uint32_t _rseed;
 		/* engine time */
 		pframes_t pulse_position () const;
+		DummyAudioBackend& engine () const { return _engine; }
 
 		// signal generator
 		volatile bool _gen_cycle;
 		Glib::Threads::Mutex generator_lock;
 
         private:
-		AudioBackend& _engine;
+		DummyAudioBackend& _engine;
 
 }; // class DummyPort
 
@@ -333,6 +335,12 @@ class DummyAudioBackend : public AudioBackend, public PortEngineSharedImpl
 
 		static size_t max_buffer_size() {return _max_buffer_size;}
 
+		/* input ports with a single connection alias the source buffer,
+		 * count the bytes that no longer need to be copied.
+		 */
+		void count_aliased_buffer (size_t bytes) { _aliased_bytes.fetch_add (bytes, std::memory_order_relaxed); }
+		size_t aliased_bytes_per_cycle () const { return _aliased_bytes_per_cycle; }
+
 	private:
 		enum MidiPortMode {
 			MidiNoEvents,
@@ -359,6 +367,7 @@ class DummyAudioBackend : public AudioBackend, public PortEngineSharedImpl
 		bool  _freewheeling;
 		bool  _realtime;
 		float _speedup;
+		bool  _report_xruns;
 
 		std::string _device;
 
@@ -380,6 +389,11 @@ class DummyAudioBackend : public AudioBackend, public PortEngineSharedImpl
 
 		samplecnt_t _processed_samples;
 
+		std::atomic<size_t> _aliased_bytes;
+		size_t              _aliased_bytes_per_cycle;
+		uint64_t            _aliased_bytes_total;
+		uint64_t            _n_cycles;
+
 		pthread_t _main_thread;
 
 		/* process threads */
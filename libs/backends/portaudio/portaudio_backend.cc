@@ -1590,11 +1590,11 @@ PortAudioBackend::blocking_process_main(const float* interleaved_input_data,
 
 	process_incoming_midi ();
 
-	/* clear output buffers */
+	/* clear output buffers, get_buffer() may return the buffer of a connected capture port */
 	for (std::vector<BackendPortPtr>::const_iterator it = _system_outputs.begin();
 	     it != _system_outputs.end();
 	     ++it) {
-		memset((*it)->get_buffer(_samples_per_period),
+		memset(static_cast<PortAudioPort*>(it->get())->buffer(),
 		       0,
 		       _samples_per_period * sizeof(Sample));
 	}
@@ -1875,6 +1875,11 @@ void* PortAudioPort::get_buffer (pframes_t n_samples)
 		std::set<BackendPortPtr>::const_iterator it = get_connections ().begin ();
 		if (it == get_connections ().end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
+		} else if (get_connections ().size () == 1) {
+			/* single source, use its buffer directly, no copy needed */
+			std::shared_ptr<const PortAudioPort> source = std::dynamic_pointer_cast<const PortAudioPort>(*it);
+			assert (source && source->is_output ());
+			return const_cast<Sample*> (source->const_buffer ());
 		} else {
 			std::shared_ptr<const PortAudioPort> source = std::dynamic_pointer_cast<const PortAudioPort>(*it);
 			assert (source && source->is_output ());
@@ -1168,6 +1168,11 @@ PulseAudioPort::get_buffer (pframes_t n_samples)
 
 		if (it == connections.end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
+		} else if (connections.size () == 1) {
+			/* single source, use its buffer directly, no copy needed */
+			std::shared_ptr<PulseAudioPort> source = std::dynamic_pointer_cast<PulseAudioPort> (*it);
+			assert (source && source->is_output ());
+			return const_cast<Sample*> (source->const_buffer ());
 		} else {
 			std::shared_ptr<PulseAudioPort> source = std::dynamic_pointer_cast<PulseAudioPort> (*it);
 			assert (source && source->is_output ());
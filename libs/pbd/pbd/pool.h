@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -61,6 +62,16 @@ public:
 	{
 		return free_list.bufsize ();
 	}
+	/** @return the largest number of items that were in use at the same time */
+	guint max_usage () const
+	{
+		return _max_usage.load ();
+	}
+	/** restart the high-water mark from the current usage */
+	void reset_max_usage ()
+	{
+		_max_usage = used ();
+	}
 
 protected:
 	PBD::RingBuffer<void*> free_list; ///< a list of pointers to free items within block
@@ -68,11 +79,9 @@ protected:
 	std::string _name;
 
 private:
-	void*            _block; ///< data storage area
-	PoolDumpCallback _dump;  ///< callback to print pool contents
-#ifndef NDEBUG
-	unsigned long max_usage;
-#endif
+	void*              _block;     ///< data storage area
+	PoolDumpCallback   _dump;      ///< callback to print pool contents
+	std::atomic<guint> _max_usage; ///< high-water mark
 };
 
 class LIBPBD_API SingleAllocMultiReleasePool : public Pool
@@ -22,6 +22,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <string>
@@ -127,7 +128,11 @@ public:
 class LIBPBD_API TimingStats : public Timing
 {
 public:
+	/** number of histogram bins, the last bin collects all outliers */
+	static const size_t histogram_bins = 128;
+
 	TimingStats ()
+		: _hist_width (0)
 	{
 		/* override implicit Timing::start () */
 		reset ();
@@ -168,6 +173,36 @@ public:
 		_avg = 0.;
 		_vm  = 0.;
 		_vs  = 0.;
+		for (size_t i = 0; i < histogram_bins; ++i) {
+			_hist[i] = 0;
+		}
+	}
+
+	/** Enable collecting a histogram of measured intervals.
+	 * This must not be called concurrently with update ().
+	 * @param width bin-width in microseconds, 0: disable histogram
+	 */
+	void set_histogram_bin_width (microseconds_t width)
+	{
+		_hist_width = width;
+		reset ();
+	}
+
+	microseconds_t histogram_bin_width () const {
+		return _hist_width;
+	}
+
+	bool get_histogram (std::vector<uint64_t>& hist) const
+	{
+		if (_hist_width == 0 || _cnt == 0) {
+			return false;
+		}
+		hist.assign (_hist, _hist + histogram_bins);
+		return true;
+	}
+
+	microseconds_t count () const {
+		return _cnt;
 	}
 
 	bool valid () const {
@@ -203,6 +238,10 @@ private:
 			_min = diff;
 		}
 
+		if (_hist_width > 0) {
+			++_hist[std::min<microseconds_t> (diff / _hist_width, histogram_bins - 1)];
+		}
+
 		if (_cnt == 0) {
 			_vm = (double) diff;
 		} else {
@@ -221,6 +260,9 @@ private:
 	double   _vm;
 	double   _vs;
 	int      _queue_reset;
+
+	microseconds_t _hist_width;
+	uint64_t       _hist[histogram_bins];
 };
 
 /** Provides an exception (and return path)-safe method to measure a timer
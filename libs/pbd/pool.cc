@@ -39,9 +39,7 @@ Pool::Pool (string n, unsigned long item_size, unsigned long nitems, PoolDumpCal
 	: free_list (nitems)
 	, _name (n)
 	, _dump (cb)
-#ifndef NDEBUG
-	, max_usage (0)
-#endif
+	, _max_usage (0)
 {
 	_name = n;
 	/* adjust to actual size (power-of-two) */
@@ -66,7 +64,7 @@ Pool::Pool (string n, unsigned long item_size, unsigned long nitems, PoolDumpCal
 
 Pool::~Pool ()
 {
-	DEBUG_TRACE (DEBUG::Pool, string_compose ("Pool: '%1' max: %2 / %3\n", name (), max_usage, total ()));
+	DEBUG_TRACE (DEBUG::Pool, string_compose ("Pool: '%1' max: %2 / %3\n", name (), max_usage (), total ()));
 	free (_block);
 }
 
@@ -78,11 +76,9 @@ Pool::alloc ()
 {
 	void* ptr;
 
-#ifndef NDEBUG
-	if (used () > max_usage) {
-		max_usage = used () + 1;
+	if (used () >= _max_usage.load ()) {
+		_max_usage = used () + 1;
 	}
-#endif
 
 	if (free_list.read (&ptr, 1) < 1) {
 		PBD::stacktrace (std::cerr, 20);
@@ -121,6 +121,10 @@ WaveView::init ()
 
 WaveView::~WaveView ()
 {
+	if (current_request) {
+		current_request->cancel ();
+	}
+
 #ifdef ENABLE_THREADED_WAVEFORM_RENDERING
 	WaveViewThreads::deinitialize ();
 #endif
@@ -204,6 +208,12 @@ WaveView::set_samples_per_pixel (double samples_per_pixel)
 		_props->samples_per_pixel = samples_per_pixel;
 		set_bbox_dirty ();
 
+		/* any pending image is for the previous zoom level */
+		if (current_request) {
+			current_request->cancel ();
+			current_request.reset ();
+		}
+
 		end_change ();
 	}
 }
@@ -279,7 +289,7 @@ WaveView::prepare_for_render (Rect const& area) const
 
 	std::shared_ptr<WaveViewDrawRequest> request = create_draw_request (required_props);
 
-	queue_draw_request (request);
+	queue_draw_request (request, false);
 }
 
 bool
@@ -333,7 +343,7 @@ WaveView::get_item_and_draw_rect_in_window_coords (Rect const& canvas_rect, Rect
 }
 
 void
-WaveView::queue_draw_request (std::shared_ptr<WaveViewDrawRequest> const& request) const
+WaveView::queue_draw_request (std::shared_ptr<WaveViewDrawRequest> const& request, bool urgent) const
 {
 	// Don't enqueue any requests without a thread to dequeue them.
 	assert (WaveViewThreads::enabled());
@@ -364,7 +374,7 @@ WaveView::queue_draw_request (std::shared_ptr<WaveViewDrawRequest> const& reques
 		// Add it to the cache so that other WaveViews can refer to the same image
 		get_cache_group()->add_image (current_request->image);
 
-		WaveViewThreads::enqueue_draw_request (current_request);
+		WaveViewThreads::enqueue_draw_request (current_request, urgent);
 	}
 }
 
@@ -1077,7 +1087,7 @@ WaveView::render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) cons
 		} else {
 			// Defer the rendering to another thread or perhaps render pass if
 			// a thread cannot generate it in time.
-			queue_draw_request (request);
+			queue_draw_request (request, true);
 			redraw ();
 			return;
 		}
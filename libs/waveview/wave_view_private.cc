@@ -17,6 +17,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <cmath>
 #include "ardour/lmath.h"
 
@@ -257,6 +258,7 @@ WaveViewCache::set_image_cache_threshold (uint64_t sz)
 
 WaveViewThreads::WaveViewThreads ()
 	: _quit (false)
+	, _queue_seq (0)
 {
 }
 
@@ -290,21 +292,43 @@ WaveViewThreads::deinitialize ()
 }
 
 void
-WaveViewThreads::enqueue_draw_request (std::shared_ptr<WaveViewDrawRequest>& request)
+WaveViewThreads::enqueue_draw_request (std::shared_ptr<WaveViewDrawRequest>& request, bool urgent)
 {
 	assert (instance);
-	instance->_enqueue_draw_request (request);
+	instance->_enqueue_draw_request (request, urgent);
 }
 
 void
-WaveViewThreads::_enqueue_draw_request (std::shared_ptr<WaveViewDrawRequest>& request)
+WaveViewThreads::_enqueue_draw_request (std::shared_ptr<WaveViewDrawRequest>& request, bool urgent)
 {
 	Glib::Threads::Mutex::Lock lm (_queue_mutex);
-	_queue.push_back (request);
+
+	/* cancelled requests are skipped when dequeued, but a fast zoom can
+	 * queue them faster than the threads pop them. Don't let them pile up.
+	 */
+	if (_queue.size () >= 64) {
+		drop_stopped_requests ();
+	}
+
+	_queue.push_back (QueuedDrawRequest (request, urgent, ++_queue_seq));
+	std::push_heap (_queue.begin (), _queue.end ());
 	/* wake one (random) thread */
 	_cond.signal ();
 }
 
+void
+WaveViewThreads::drop_stopped_requests ()
+{
+	/* _queue_mutex must be held at this point */
+
+	DrawRequestQueueType::iterator i = std::remove_if (_queue.begin (), _queue.end (),
+	                                                   [] (QueuedDrawRequest const& q) { return q.request->stopped (); });
+	if (i != _queue.end ()) {
+		_queue.erase (i, _queue.end ());
+		std::make_heap (_queue.begin (), _queue.end ());
+	}
+}
+
 std::shared_ptr<WaveViewDrawRequest>
 WaveViewThreads::dequeue_draw_request ()
 {
@@ -327,11 +351,17 @@ WaveViewThreads::_dequeue_draw_request ()
 
 	/* queue could be empty at this point because an already running thread
 	 * pulled the request before we were fully awake and reacquired the mutex.
+	 *
+	 * Skip over requests that were cancelled while queued, there is
+	 * no point in waking up again just to discard them.
 	 */
 
-	if (!_queue.empty()) {
-		req = _queue.front ();
-		_queue.pop_front ();
+	while (!_queue.empty() && !req) {
+		std::pop_heap (_queue.begin (), _queue.end ());
+		if (!_queue.back ().request->stopped ()) {
+			req = _queue.back ().request;
+		}
+		_queue.pop_back ();
 	}
 
 	return req;
@@ -344,12 +374,12 @@ WaveViewThreads::start_threads ()
 
 	const int num_cpus = hardware_concurrency ();
 
-	/* the upper limit of 8 here is entirely arbitrary. It just doesn't
-	 * seem worthwhile having "ncpus" of low priority threads for
-	 * rendering waveforms into the cache.
+	/* leave one core for the GUI thread. The upper limit here is
+	 * entirely arbitrary, beyond that peak-file I/O rather than
+	 * rendering is the bottleneck.
 	 */
 
-	uint32_t num_threads = std::min (8, std::max (1, num_cpus - 1));
+	uint32_t num_threads = std::min (16, std::max (1, num_cpus - 1));
 
 	for (uint32_t i = 0; i != num_threads; ++i) {
 		std::shared_ptr<WaveViewDrawingThread> new_thread (new WaveViewDrawingThread ());
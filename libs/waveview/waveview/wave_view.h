@@ -236,7 +236,7 @@ private:
 
 	std::shared_ptr<WaveViewDrawRequest> create_draw_request (WaveViewProperties const&) const;
 
-	void queue_draw_request (std::shared_ptr<WaveViewDrawRequest> const&) const;
+	void queue_draw_request (std::shared_ptr<WaveViewDrawRequest> const&, bool urgent) const;
 
 	static void process_draw_request (std::shared_ptr<WaveViewDrawRequest>);
 
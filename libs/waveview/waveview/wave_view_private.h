@@ -19,7 +19,7 @@
 #ifndef _WAVEVIEW_WAVE_VIEW_PRIVATE_H_
 #define _WAVEVIEW_WAVE_VIEW_PRIVATE_H_
 
-#include <deque>
+#include <vector>
 
 #include "pbd/pthread_utils.h"
 #include "waveview/wave_view.h"
@@ -313,7 +313,10 @@ public:
 
 	static bool enabled () { return (instance); }
 
-	static void enqueue_draw_request (std::shared_ptr<WaveViewDrawRequest>&);
+	/* @param urgent true if the request is needed to render a currently
+	 * exposed area, rather than to prepare an image ahead of time.
+	 */
+	static void enqueue_draw_request (std::shared_ptr<WaveViewDrawRequest>&, bool urgent);
 
 private:
 	friend class WaveViewDrawingThread;
@@ -323,7 +326,8 @@ private:
 	static void thread_proc ();
 
 	std::shared_ptr<WaveViewDrawRequest> _dequeue_draw_request ();
-	void _enqueue_draw_request (std::shared_ptr<WaveViewDrawRequest>&);
+	void _enqueue_draw_request (std::shared_ptr<WaveViewDrawRequest>&, bool urgent);
+	void drop_stopped_requests ();
 	void _thread_proc ();
 
 	void start_threads ();
@@ -343,8 +347,30 @@ private:
 	mutable Glib::Threads::Mutex _queue_mutex;
 	Glib::Threads::Cond _cond;
 
-	typedef std::deque<std::shared_ptr<WaveViewDrawRequest> > DrawRequestQueueType;
+	/* Requests are kept in a heap: urgent requests come first, and within
+	 * the same urgency the most recently queued one. During zoom or scroll
+	 * this serves the current view before requests that were queued for a
+	 * previous one (which are likely to be cancelled by then anyway).
+	 */
+	struct QueuedDrawRequest {
+		QueuedDrawRequest (std::shared_ptr<WaveViewDrawRequest> const& r, bool u, uint64_t s)
+			: request (r), urgent (u), seq (s) {}
+
+		bool operator< (QueuedDrawRequest const& other) const {
+			if (urgent != other.urgent) {
+				return !urgent;
+			}
+			return seq < other.seq;
+		}
+
+		std::shared_ptr<WaveViewDrawRequest> request;
+		bool     urgent;
+		uint64_t seq;
+	};
+
+	typedef std::vector<QueuedDrawRequest> DrawRequestQueueType;
 	DrawRequestQueueType _queue;
+	uint64_t             _queue_seq;
 };
 
 
@@ -22,10 +22,67 @@
 #include <string.h>
 #include <math.h>
 
+#if defined __AVX__
+#include <immintrin.h>
+#elif defined __SSE__
+#include <xmmintrin.h>
+#elif defined __ARM_NEON__ || defined __ARM_NEON
+#include <arm_neon.h>
+#define ZR_NEON
+#endif
+
 #include "zita-resampler/resampler.h"
 
 using namespace ArdourZita;
 
+// Returns sum (p1 [i] * c1 [i] + p2 [-i-1] * c2 [i]) for 0 <= i < hl,
+// i.e. applies both halves of the filter to a single channel.
+static inline float
+filter_mono (float const* p1, float const* p2, float const* c1, float const* c2, int hl)
+{
+	int i = 0;
+#if defined __AVX__
+	__m256 s0 = _mm256_setzero_ps ();
+	for (; i + 8 <= hl; i += 8) {
+		__m256 x2 = _mm256_loadu_ps (p2 - i - 8);
+		x2 = _mm256_permute2f128_ps (x2, x2, 1);
+		x2 = _mm256_permute_ps (x2, _MM_SHUFFLE (0, 1, 2, 3));
+		s0 = _mm256_add_ps (s0, _mm256_mul_ps (_mm256_loadu_ps (p1 + i), _mm256_loadu_ps (c1 + i)));
+		s0 = _mm256_add_ps (s0, _mm256_mul_ps (x2, _mm256_loadu_ps (c2 + i)));
+	}
+	__m128 r = _mm_add_ps (_mm256_castps256_ps128 (s0), _mm256_extractf128_ps (s0, 1));
+	r = _mm_add_ps (r, _mm_movehl_ps (r, r));
+	r = _mm_add_ss (r, _mm_shuffle_ps (r, r, 1));
+	float s = _mm_cvtss_f32 (r);
+#elif defined __SSE__
+	__m128 s0 = _mm_setzero_ps ();
+	for (; i + 4 <= hl; i += 4) {
+		__m128 x2 = _mm_loadu_ps (p2 - i - 4);
+		x2 = _mm_shuffle_ps (x2, x2, _MM_SHUFFLE (0, 1, 2, 3));
+		s0 = _mm_add_ps (s0, _mm_mul_ps (_mm_loadu_ps (p1 + i), _mm_loadu_ps (c1 + i)));
+		s0 = _mm_add_ps (s0, _mm_mul_ps (x2, _mm_loadu_ps (c2 + i)));
+	}
+	s0 = _mm_add_ps (s0, _mm_movehl_ps (s0, s0));
+	s0 = _mm_add_ss (s0, _mm_shuffle_ps (s0, s0, 1));
+	float s = _mm_cvtss_f32 (s0);
+#elif defined ZR_NEON
+	float32x4_t s0 = vdupq_n_f32 (0);
+	for (; i + 4 <= hl; i += 4) {
+		float32x4_t x2 = vrev64q_f32 (vld1q_f32 (p2 - i - 4));
+		x2 = vcombine_f32 (vget_high_f32 (x2), vget_low_f32 (x2));
+		s0 = vmlaq_f32 (vmlaq_f32 (s0, vld1q_f32 (p1 + i), vld1q_f32 (c1 + i)), x2, vld1q_f32 (c2 + i));
+	}
+	float32x2_t h = vadd_f32 (vget_low_f32 (s0), vget_high_f32 (s0));
+	float s = vget_lane_f32 (vpadd_f32 (h, h), 0);
+#else
+	float s = 0;
+#endif
+	for (; i < hl; i++) {
+		s += p1 [i] * c1 [i] + p2 [-i-1] * c2 [i];
+	}
+	return s;
+}
+
 static unsigned int gcd (unsigned int a, unsigned int b)
 {
 	if (a == 0) return b;
@@ -198,16 +255,37 @@ Resampler::process (void)
 				if (nz < 2 * hl) {
 					float *c1 = _table->_ctab + hl * ph;
 					float *c2 = _table->_ctab + hl * (np - ph);
-					for (c = 0; c < _nchan; c++) {
-						float *q1 = p1 + c;
-						float *q2 = p2 + c;
-						float s = 1e-20f;
+					if (_nchan == 1) {
+						*out_data++ = filter_mono (p1, p2, c1, c2, hl);
+					} else if (_nchan < 4) {
+						for (c = 0; c < _nchan; c++) {
+							float *q1 = p1 + c;
+							float *q2 = p2 + c;
+							float s = 1e-20f;
+							for (i = 0; i < hl; i++) {
+								q2 -= _nchan;
+								s += *q1 * c1 [i] + *q2 * c2 [i];
+								q1 += _nchan;
+							}
+							*out_data++ = s - 1e-20f;
+						}
+					} else {
+						// Accumulate all channels at once, directly in the
+						// (interleaved) output. The inner loop runs over
+						// adjacent samples, which allows it to be vectorized.
+						float *q1 = p1;
+						float *q2 = p2;
+						for (c = 0; c < _nchan; c++) out_data [c] = 1e-20f;
 						for (i = 0; i < hl; i++) {
 							q2 -= _nchan;
-							s += *q1 * c1 [i] + *q2 * c2 [i];
+							const float a1 = c1 [i];
+							const float a2 = c2 [i];
+							for (c = 0; c < _nchan; c++) {
+								out_data [c] += q1 [c] * a1 + q2 [c] * a2;
+							}
 							q1 += _nchan;
 						}
-						*out_data++ = s - 1e-20f;
+						for (c = 0; c < _nchan; c++) *out_data++ -= 1e-20f;
 					}
 				} else {
 					for (c = 0; c < _nchan; c++) *out_data++ = 0;
@@ -24,15 +24,86 @@
 #include <math.h>
 #include <algorithm>
 
+#if defined __AVX__
+#include <immintrin.h>
+#elif defined __SSE__
+#include <xmmintrin.h>
+#elif defined __ARM_NEON__ || defined __ARM_NEON
+#include <arm_neon.h>
+#define VMR_NEON
+#endif
+
 #include "zita-resampler/vmresampler.h"
 
 using namespace ArdourZita;
 
+// Apply both halves of the filter, interpolating between adjacent
+// filter phases (cq [i] and cq [i +/- hl]) with weights aa, bb.
+// Input samples for the 2nd half are read backwards from p2 [-1].
+// This replaces computing the interpolated coefficients first,
+// and uses explicit SIMD where available.
+static inline float
+filter2 (float const* p1, float const* p2, float const* cq1, float const* cq2, float aa, float bb, int hl)
+{
+	float a0 = 0;
+	float a1 = 0;
+	int   i  = 0;
+#if defined __AVX__
+	__m256 s0 = _mm256_setzero_ps ();
+	__m256 s1 = _mm256_setzero_ps ();
+	for (; i + 8 <= hl; i += 8) {
+		__m256 x1 = _mm256_loadu_ps (p1 + i);
+		__m256 x2 = _mm256_loadu_ps (p2 - i - 8);
+		x2 = _mm256_permute2f128_ps (x2, x2, 1);
+		x2 = _mm256_permute_ps (x2, _MM_SHUFFLE (0, 1, 2, 3));
+		s0 = _mm256_add_ps (s0, _mm256_add_ps (_mm256_mul_ps (x1, _mm256_loadu_ps (cq1 + i)), _mm256_mul_ps (x2, _mm256_loadu_ps (cq2 + i))));
+		s1 = _mm256_add_ps (s1, _mm256_add_ps (_mm256_mul_ps (x1, _mm256_loadu_ps (cq1 + i + hl)), _mm256_mul_ps (x2, _mm256_loadu_ps (cq2 + i - hl))));
+	}
+	__m256 s = _mm256_add_ps (_mm256_mul_ps (s0, _mm256_set1_ps (aa)), _mm256_mul_ps (s1, _mm256_set1_ps (bb)));
+	__m128 r = _mm_add_ps (_mm256_castps256_ps128 (s), _mm256_extractf128_ps (s, 1));
+	r = _mm_add_ps (r, _mm_movehl_ps (r, r));
+	r = _mm_add_ss (r, _mm_shuffle_ps (r, r, 1));
+	float a = _mm_cvtss_f32 (r);
+#elif defined __SSE__
+	__m128 s0 = _mm_setzero_ps ();
+	__m128 s1 = _mm_setzero_ps ();
+	for (; i + 4 <= hl; i += 4) {
+		__m128 x1 = _mm_loadu_ps (p1 + i);
+		__m128 x2 = _mm_loadu_ps (p2 - i - 4);
+		x2 = _mm_shuffle_ps (x2, x2, _MM_SHUFFLE (0, 1, 2, 3));
+		s0 = _mm_add_ps (s0, _mm_add_ps (_mm_mul_ps (x1, _mm_loadu_ps (cq1 + i)), _mm_mul_ps (x2, _mm_loadu_ps (cq2 + i))));
+		s1 = _mm_add_ps (s1, _mm_add_ps (_mm_mul_ps (x1, _mm_loadu_ps (cq1 + i + hl)), _mm_mul_ps (x2, _mm_loadu_ps (cq2 + i - hl))));
+	}
+	__m128 r = _mm_add_ps (_mm_mul_ps (s0, _mm_set1_ps (aa)), _mm_mul_ps (s1, _mm_set1_ps (bb)));
+	r = _mm_add_ps (r, _mm_movehl_ps (r, r));
+	r = _mm_add_ss (r, _mm_shuffle_ps (r, r, 1));
+	float a = _mm_cvtss_f32 (r);
+#elif defined VMR_NEON
+	float32x4_t s0 = vdupq_n_f32 (0);
+	float32x4_t s1 = vdupq_n_f32 (0);
+	for (; i + 4 <= hl; i += 4) {
+		float32x4_t x1 = vld1q_f32 (p1 + i);
+		float32x4_t x2 = vrev64q_f32 (vld1q_f32 (p2 - i - 4));
+		x2 = vcombine_f32 (vget_high_f32 (x2), vget_low_f32 (x2));
+		s0 = vmlaq_f32 (vmlaq_f32 (s0, x1, vld1q_f32 (cq1 + i)), x2, vld1q_f32 (cq2 + i));
+		s1 = vmlaq_f32 (vmlaq_f32 (s1, x1, vld1q_f32 (cq1 + i + hl)), x2, vld1q_f32 (cq2 + i - hl));
+	}
+	float32x4_t r = vmlaq_n_f32 (vmulq_n_f32 (s0, aa), s1, bb);
+	float32x2_t h = vadd_f32 (vget_low_f32 (r), vget_high_f32 (r));
+	float a = vget_lane_f32 (vpadd_f32 (h, h), 0);
+#else
+	float a = 0;
+#endif
+	for (; i < hl; i++) {
+		a0 += p1 [i] * cq1 [i] + p2 [-i-1] * cq2 [i];
+		a1 += p1 [i] * cq1 [i + hl] + p2 [-i-1] * cq2 [i - hl];
+	}
+	return a + aa * a0 + bb * a1;
+}
+
 VMResampler::VMResampler (void)
 	: _table (0)
   , _buff  (0)
-  , _c1 (0)
-  , _c2 (0)
   , _reset (false)
 {
 	reset ();
@@ -66,8 +137,6 @@ VMResampler::setup (unsigned int hlen, double frel)
 	if (T) {
 		_table = T;
 		_buff  = new float [2 * h - 1 + k];
-		_c1 = new float [2 * h];
-		_c2 = new float [2 * h];
 		_inmax = k;
 		_pstep = s;
 		_qstep = s;
@@ -82,11 +151,7 @@ VMResampler::clear (void)
 {
 	Resampler_table::destroy (_table);
 	delete[] _buff;
-	delete[] _c1;
-	delete[] _c2;
 	_buff  = 0;
-	_c1 = 0;
-	_c2 = 0;
 	_table = 0;
 	_inmax = 0;
 	_pstep = 0;
@@ -246,15 +311,8 @@ VMResampler::process (void)
 				const float aa = 1.0f - bb;
 				float const* cq1 = _table->_ctab + hl * k;
 				float const* cq2 = _table->_ctab + hl * (np - k);
-				for (int i = 0; i < hl; i++) {
-					_c1 [i] = aa * cq1 [i] + bb * cq1 [i + hl];
-					_c2 [i] = aa * cq2 [i] + bb * cq2 [i - hl];
-				}
 
-				a = 1e-25f;
-				for (int i = 0; i < hl; i++) {
-					a += p1[i] * _c1 [i] + p2[-i-1] * _c2 [i];
-				}
+				a = 1e-25f + filter2 (p1, p2, cq1, cq2, aa, bb, hl);
 				*out_data++ = a - 1e-25f;
 			}
 			out_count--;
@@ -64,8 +64,6 @@ private:
 	double               _qstep;
 	double               _wstep;
 	float               *_buff;
-	float               *_c1;
-	float               *_c2;
 	bool                 _reset;
 };
 
@@ -0,0 +1,412 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <getopt.h>
+
+#include <glib/gstdio.h>
+#include <glibmm.h>
+
+#include "pbd/file_utils.h"
+#include "pbd/signals.h"
+#include "pbd/timing.h"
+
+#include "ardour/audio_backend.h"
+#include "ardour/audio_track.h"
+#include "ardour/audioengine.h"
+#include "ardour/graph.h"
+#include "ardour/lua_api.h"
+#include "ardour/monitor_control.h"
+#include "ardour/rc_configuration.h"
+
+#include "common.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace SessionUtils;
+
+static std::atomic<int> xrun_count (0);
+
+static void
+xrun_callback ()
+{
+	++xrun_count;
+}
+
+static void usage ()
+{
+	// help2man compatible format (standard GNU help-text)
+	printf (UTILNAME " - synthetic realtime performance benchmark.\n\n");
+	printf ("Usage: " UTILNAME " [ OPTIONS ]\n\n");
+	printf ("Options:\n\
+  -b, --buffersize <n>       samples per cycle (default 1024)\n\
+  -c, --cycles <n>           number of process cycles to run (default 5000)\n\
+  -D, --driver <name>        dummy-backend driver, sets pacing\n\
+                             (default: the unpaced 'Unlimited Speed')\n\
+  -d, --device <name>        dummy-backend device (test-signal) to use\n\
+  -h, --help                 display this help and exit\n\
+  -j, --threads <n>          number of DSP threads (default: all CPUs)\n\
+  -o, --output <file>        write JSON report to file (default: stdout)\n\
+  -P, --plugin <uri>         LV2 plugin to use (default urn:ardour:a-eq)\n\
+  -p, --plugins <n>          number of plugins per track (default 2)\n\
+  -s, --samplerate <rate>    samplerate to use (default 48000)\n\
+  -t, --tracks <n>           number of mono audio tracks (default 32)\n\
+  -V, --version              print version information and exit\n\
+\n");
+
+	printf ("\n\
+This tool creates a temporary session with the given number of tracks,\n\
+each with input-monitoring enabled and a chain of plugins, and processes\n\
+it using the dummy backend for the given number of cycles.\n\
+\n\
+The report is JSON and includes a histogram of per-cycle DSP time\n\
+(bin-width is 1/32 of the nominal cycle duration, the last bin collects\n\
+all outliers), the number of cycles that took longer than the nominal\n\
+cycle-duration, reported xruns and process-graph thread utilization.\n\
+\n\
+Xruns are only reported with real-time pacing, e.g. '-D Realtime'\n\
+or '-D \"Normal Speed\"'.\n\
+\n");
+
+	printf ("\n\
+Examples:\n\
+" UTILNAME " -t 64 -p 4 -j 4 -b 256 -o /tmp/bench.json\n\
+\n");
+
+	printf ("Report bugs to <https://tracker.ardour.org/>\n"
+	        "Website: <https://ardour.org/>\n");
+	::exit (EXIT_SUCCESS);
+}
+
+static bool
+setup_engine (std::string const& driver, std::string const& device, float sample_rate, uint32_t buffer_size)
+{
+	AudioEngine* engine = AudioEngine::create ();
+
+	std::shared_ptr<AudioBackend> backend = engine->set_backend ("None (Dummy)", "Unit-Test", "");
+	if (!backend) {
+		std::cerr << "Cannot create Audio/MIDI engine\n";
+		return false;
+	}
+
+	/* ask the dummy backend to report cycles that exceed the period as xruns */
+	g_setenv ("ARDOUR_DUMMY_XRUNS", "1", 1);
+
+	std::vector<std::string> drivers = backend->enumerate_drivers ();
+	if (driver.empty () && !drivers.empty ()) {
+		/* last entry runs cycles back to back, without pacing */
+		backend->set_driver (drivers.back ());
+	} else if (backend->set_driver (driver)) {
+		std::cerr << "Cannot use driver '" << driver << "'\n";
+		return false;
+	}
+
+	if (!device.empty () && engine->set_device_name (device)) {
+		std::cerr << "Cannot use device '" << device << "'\n";
+		return false;
+	}
+
+	if (engine->set_sample_rate (sample_rate)) {
+		std::cerr << "Cannot set samplerate.\n";
+		return false;
+	}
+
+	if (engine->set_buffer_size (buffer_size)) {
+		std::cerr << "Cannot set buffer-size.\n";
+		return false;
+	}
+
+	if (engine->start () != 0) {
+		std::cerr << "Cannot start Audio/MIDI engine\n";
+		return false;
+	}
+	return true;
+}
+
+static bool
+populate_session (Session* s, uint32_t n_tracks, uint32_t n_plugins, std::string const& uri)
+{
+	std::list<std::shared_ptr<AudioTrack> > tracks = s->new_audio_track (1, 2, 0, n_tracks, "Bench", PresentationInfo::max_order);
+
+	if (tracks.size () != n_tracks) {
+		std::cerr << "Cannot create tracks\n";
+		return false;
+	}
+
+	for (std::list<std::shared_ptr<AudioTrack> >::const_iterator i = tracks.begin (); i != tracks.end (); ++i) {
+		for (uint32_t p = 0; p < n_plugins; ++p) {
+			std::shared_ptr<Processor> proc = LuaAPI::new_plugin (s, uri, LV2);
+			if (!proc) {
+				std::cerr << "Cannot instantiate plugin '" << uri << "'\n";
+				return false;
+			}
+			if ((*i)->add_processor_by_index (proc, -1, 0, true)) {
+				std::cerr << "Cannot add plugin to track\n";
+				return false;
+			}
+		}
+		(*i)->monitoring_control ()->set_value (MonitorInput, PBD::Controllable::NoGroup);
+	}
+	return true;
+}
+
+static void
+write_report (FILE* f, Session* s, uint32_t n_tracks, uint32_t n_plugins, uint32_t n_threads, PBD::microseconds_t bin_width)
+{
+	AudioEngine* engine = AudioEngine::instance ();
+	PBD::TimingStats const& ts (s->dsp_stats[Session::OverallProcess]);
+
+	PBD::microseconds_t min = 0;
+	PBD::microseconds_t max = 0;
+	double avg = 0;
+	double dev = 0;
+	ts.get_stats (min, max, avg, dev);
+
+	std::vector<uint64_t> hist;
+	ts.get_histogram (hist);
+
+	/* cycles that took longer than the nominal cycle duration */
+	uint64_t overruns = 0;
+	for (size_t i = 32; i < hist.size (); ++i) {
+		overruns += hist[i];
+	}
+
+	uint64_t nodes_run = 0;
+	PBD::microseconds_t busy_time = 0;
+	s->process_graph ()->get_stats (nodes_run, busy_time);
+
+	const double dsp_time    = avg * ts.count ();
+	const double utilization = dsp_time > 0 ? busy_time / (dsp_time * n_threads) : 0;
+
+	fprintf (f, "{\n");
+	fprintf (f, "  \"tracks\": %u,\n", n_tracks);
+	fprintf (f, "  \"plugins_per_track\": %u,\n", n_plugins);
+	fprintf (f, "  \"samplerate\": %u,\n", (unsigned int) engine->sample_rate ());
+	fprintf (f, "  \"buffer_size\": %u,\n", (unsigned int) engine->samples_per_cycle ());
+	fprintf (f, "  \"cycles\": %lld,\n", (long long) ts.count ());
+	fprintf (f, "  \"cycle_usec\": %d,\n", engine->usecs_per_cycle ());
+	fprintf (f, "  \"dsp_usec\": { \"min\": %lld, \"max\": %lld, \"avg\": %.2f, \"dev\": %.2f },\n",
+	         (long long) min, (long long) max, avg, dev);
+	fprintf (f, "  \"histogram\": { \"bin_usec\": %lld, \"bins\": [", (long long) bin_width);
+	for (size_t i = 0; i < hist.size (); ++i) {
+		fprintf (f, "%s%llu", i > 0 ? ", " : "", (unsigned long long) hist[i]);
+	}
+	fprintf (f, "] },\n");
+	fprintf (f, "  \"overruns\": %llu,\n", (unsigned long long) overruns);
+	fprintf (f, "  \"xruns\": %d,\n", xrun_count.load ());
+	fprintf (f, "  \"graph\": { \"threads\": %u, \"nodes_run\": %llu, \"busy_usec\": %lld, \"utilization\": %.4f }\n",
+	         n_threads, (unsigned long long) nodes_run, (long long) busy_time, utilization);
+	fprintf (f, "}\n");
+}
+
+int main (int argc, char* argv[])
+{
+	int         sample_rate = 48000;
+	uint32_t    buffer_size = 1024;
+	uint32_t    n_cycles    = 5000;
+	uint32_t    n_tracks    = 32;
+	uint32_t    n_plugins   = 2;
+	int         n_threads   = 0;
+	std::string plugin_uri  = "urn:ardour:a-eq";
+	std::string driver;
+	std::string device;
+	std::string outfile;
+
+	const char *optstring = "b:c:D:d:hj:o:P:p:s:t:V";
+
+	const struct option longopts[] = {
+		{ "buffersize", 1, 0, 'b' },
+		{ "cycles",     1, 0, 'c' },
+		{ "driver",     1, 0, 'D' },
+		{ "device",     1, 0, 'd' },
+		{ "help",       0, 0, 'h' },
+		{ "threads",    1, 0, 'j' },
+		{ "output",     1, 0, 'o' },
+		{ "plugin",     1, 0, 'P' },
+		{ "plugins",    1, 0, 'p' },
+		{ "samplerate", 1, 0, 's' },
+		{ "tracks",     1, 0, 't' },
+		{ "version",    0, 0, 'V' },
+		{ 0, 0, 0, 0 }
+	};
+
+	int c = 0;
+	while (EOF != (c = getopt_long (argc, argv,
+					optstring, longopts, (int *) 0))) {
+		switch (c) {
+			case 'b':
+				buffer_size = atoi (optarg);
+				break;
+
+			case 'c':
+				n_cycles = atoi (optarg);
+				break;
+
+			case 'D':
+				driver = optarg;
+				break;
+
+			case 'd':
+				device = optarg;
+				break;
+
+			case 'j':
+				n_threads = atoi (optarg);
+				break;
+
+			case 'o':
+				outfile = optarg;
+				break;
+
+			case 'P':
+				plugin_uri = optarg;
+				break;
+
+			case 'p':
+				n_plugins = atoi (optarg);
+				break;
+
+			case 's':
+				{
+					const int sr = atoi (optarg);
+					if (sr >= 8000 && sr <= 192000) {
+						sample_rate = sr;
+					} else {
+						fprintf(stderr, "Invalid Samplerate\n");
+					}
+				}
+				break;
+
+			case 't':
+				n_tracks = atoi (optarg);
+				break;
+
+			case 'V':
+				printf ("ardour-utils version %s\n\n", VERSIONSTRING);
+				printf ("Copyright (C) GPL 2024\n");
+				exit (EXIT_SUCCESS);
+				break;
+
+			case 'h':
+				usage ();
+				break;
+
+			default:
+				cerr << "Error: unrecognized option. See --help for usage information.\n";
+				::exit (EXIT_FAILURE);
+				break;
+		}
+	}
+
+	if (optind != argc) {
+		cerr << "Error: Extra commandline argument. See --help for usage information.\n";
+		::exit (EXIT_FAILURE);
+	}
+
+	if (n_cycles < 1 || n_tracks < 1 || buffer_size < 16) {
+		cerr << "Error: Invalid parameter. See --help for usage information.\n";
+		::exit (EXIT_FAILURE);
+	}
+
+	/* all systems go */
+
+	SessionUtils::init ();
+
+	Config->set_processor_usage (n_threads);
+
+	if (!setup_engine (driver, device, sample_rate, buffer_size)) {
+		SessionUtils::cleanup ();
+		::exit (EXIT_FAILURE);
+	}
+
+	AudioEngine* engine = AudioEngine::instance ();
+
+	gchar* tmp = g_dir_make_tmp ("ardour-bench-XXXXXX", NULL);
+	if (!tmp) {
+		cerr << "Error: Cannot create temporary folder.\n";
+		::exit (EXIT_FAILURE);
+	}
+	std::string tmpdir (tmp);
+	g_free (tmp);
+
+	Session* s = 0;
+	try {
+		s = new Session (*engine, Glib::build_filename (tmpdir, "bench"), "bench");
+	} catch (...) {
+		cerr << "Error: Cannot create session.\n";
+		PBD::remove_directory (tmpdir);
+		::exit (EXIT_FAILURE);
+	}
+
+	if (!populate_session (s, n_tracks, n_plugins, plugin_uri)) {
+		SessionUtils::unload_session (s);
+		SessionUtils::cleanup ();
+		PBD::remove_directory (tmpdir);
+		::exit (EXIT_FAILURE);
+	}
+
+	/* 32 bins per cycle, the remaining bins collect overruns (up to 4x) */
+	const PBD::microseconds_t bin_width = std::max (1, engine->usecs_per_cycle () / 32);
+
+	PBD::ScopedConnection xrun_connection;
+	engine->Xrun.connect_same_thread (xrun_connection, &xrun_callback);
+
+	{
+		/* The engine already runs the session, hold the process-lock
+		 * while setting up the stats, and discard the cycles that ran
+		 * while populating the session.
+		 */
+		Glib::Threads::Mutex::Lock lm (engine->process_lock ());
+		s->dsp_stats[Session::OverallProcess].set_histogram_bin_width (bin_width);
+		s->process_graph ()->reset_stats ();
+		s->process_graph ()->set_collect_stats (true);
+	}
+
+	while (s->dsp_stats[Session::OverallProcess].count () < n_cycles && engine->running ()) {
+		Glib::usleep (1000);
+	}
+
+	/* stop processing, so that stats remain consistent.
+	 * Note: this also terminates the graph's worker threads.
+	 */
+	const uint32_t graph_threads = s->process_graph ()->n_threads ();
+	engine->stop ();
+	xrun_connection.disconnect ();
+
+	FILE* f = stdout;
+	if (!outfile.empty ()) {
+		f = g_fopen (outfile.c_str (), "w");
+		if (!f) {
+			cerr << "Error: Cannot open output file '" << outfile << "'.\n";
+			f = stdout;
+		}
+	}
+
+	write_report (f, s, n_tracks, n_plugins, graph_threads, bin_width);
+
+	if (f != stdout) {
+		fclose (f);
+	}
+
+	SessionUtils::unload_session (s);
+	SessionUtils::cleanup ();
+	PBD::remove_directory (tmpdir);
+
+	return 0;
+}